@@ -0,0 +1,394 @@
+// BigUnsigned member functions and the factorial functions defined here
+
+#include "bignum.h"
+
+#include <algorithm>
+
+namespace
+{
+    using Limb = BigUnsigned::Limb;
+    constexpr std::uint64_t base{ BigUnsigned::base };
+
+    // Below this many limbs schoolbook multiplication beats Karatsuba
+    constexpr std::size_t karatsubaThreshold{ 40 };
+
+    // From this many limbs (in the smaller operand) the number-theoretic transform
+    // beats Karatsuba
+    constexpr std::size_t nttThreshold{ 2048 };
+
+    std::size_t trimmedSize(const Limb* limbs, std::size_t size)
+    {
+        while (size > 0 && limbs[size - 1] == 0)
+            --size;
+        return size;
+    }
+
+    // result[0..na + nb) += a * b; result must start out zero
+    void multiplySchoolbook(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limb* result)
+    {
+        for (std::size_t i{ 0 }; i < na; ++i)
+        {
+            std::uint64_t carry{ 0 };
+            for (std::size_t j{ 0 }; j < nb; ++j)
+            {
+                std::uint64_t current{ result[i + j] + static_cast<std::uint64_t>(a[i]) * b[j] + carry };
+                result[i + j] = static_cast<Limb>(current % base);
+                carry = current / base;
+            }
+            result[i + nb] = static_cast<Limb>(carry);
+        }
+    }
+
+    // target[0..targetSize) += addend[0..addendSize), carrying as far as needed
+    void addInto(Limb* target, std::size_t targetSize, const Limb* addend, std::size_t addendSize)
+    {
+        Limb carry{ 0 };
+        std::size_t i{ 0 };
+        for (; i < addendSize; ++i)
+        {
+            Limb sum{ target[i] + addend[i] + carry };
+            carry = sum >= base;
+            target[i] = carry ? sum - static_cast<Limb>(base) : sum;
+        }
+        for (; carry && i < targetSize; ++i)
+        {
+            Limb sum{ target[i] + 1 };
+            carry = sum == base;
+            target[i] = carry ? 0 : sum;
+        }
+    }
+
+    // target -= subtrahend, where target >= subtrahend
+    void subtractFrom(Limb* target, std::size_t targetSize, const Limb* subtrahend, std::size_t subtrahendSize)
+    {
+        Limb borrow{ 0 };
+        std::size_t i{ 0 };
+        for (; i < subtrahendSize; ++i)
+        {
+            Limb take{ subtrahend[i] + borrow };
+            borrow = target[i] < take;
+            target[i] = borrow ? target[i] + static_cast<Limb>(base) - take : target[i] - take;
+        }
+        for (; borrow && i < targetSize; ++i)
+        {
+            borrow = target[i] == 0;
+            target[i] = borrow ? static_cast<Limb>(base - 1) : target[i] - 1;
+        }
+    }
+
+    // result[0..2n) = a[0..n) * b[0..n); result must start out zero.
+    // Splits each operand in two and does three half-size multiplies instead of four:
+    // a * b = z2 * B^2m + ((a0 + a1)(b0 + b1) - z0 - z2) * B^m + z0
+    void multiplyKaratsuba(const Limb* a, const Limb* b, std::size_t n, Limb* result)
+    {
+        if (n < karatsubaThreshold)
+        {
+            multiplySchoolbook(a, n, b, n, result);
+            return;
+        }
+
+        std::size_t low{ n / 2 };
+        std::size_t high{ n - low };
+
+        multiplyKaratsuba(a, b, low, result);                           // z0 in result[0..2 low)
+        multiplyKaratsuba(a + low, b + low, high, result + 2 * low);    // z2 in result[2 low..2n)
+
+        std::vector<Limb> sumA(high + 1);
+        std::vector<Limb> sumB(high + 1);
+        std::copy(a + low, a + n, sumA.begin());
+        std::copy(b + low, b + n, sumB.begin());
+        addInto(sumA.data(), sumA.size(), a, low);
+        addInto(sumB.data(), sumB.size(), b, low);
+
+        std::vector<Limb> middle(2 * (high + 1));
+        multiplyKaratsuba(sumA.data(), sumB.data(), high + 1, middle.data());
+        subtractFrom(middle.data(), middle.size(), result, 2 * low);
+        subtractFrom(middle.data(), middle.size(), result + 2 * low, 2 * high);
+
+        addInto(result + low, 2 * n - low, middle.data(), trimmedSize(middle.data(), middle.size()));
+    }
+
+    // Number-theoretic transform: an FFT over integers mod a prime p with 2^k | p - 1,
+    // so the convolution is exact. Three such primes and the Chinese remainder theorem
+    // recover every column sum of a base 10^9 product (each is below 2^20 * 10^18,
+    // well under the ~7.9 * 10^25 product of the primes).
+    // 3 is a primitive root of all three. The modulus is a template parameter so the
+    // compiler can turn every % into a multiply.
+    constexpr std::uint32_t nttGenerator{ 3 };
+    constexpr std::uint32_t nttPrime0{ 998'244'353 };
+    constexpr std::uint32_t nttPrime1{ 167'772'161 };
+    constexpr std::uint32_t nttPrime2{ 469'762'049 };
+
+    // The first prime only has 2^23 roots of unity, which caps the product length
+    constexpr std::size_t nttMaxLength{ std::size_t{ 1 } << 23 };
+
+    std::uint32_t powMod(std::uint64_t value, std::uint64_t exponent, std::uint32_t modulus)
+    {
+        std::uint64_t result{ 1 };
+        value %= modulus;
+        while (exponent > 0)
+        {
+            if (exponent & 1)
+                result = result * value % modulus;
+            value = value * value % modulus;
+            exponent >>= 1;
+        }
+        return static_cast<std::uint32_t>(result);
+    }
+
+    // In-place iterative transform; data.size() must be a power of two
+    template <std::uint32_t Modulus>
+    void ntt(std::vector<std::uint32_t>& data, bool inverse)
+    {
+        std::size_t n{ data.size() };
+        constexpr std::uint64_t modulus{ Modulus };
+
+        for (std::size_t i{ 1 }, j{ 0 }; i < n; ++i)
+        {
+            std::size_t bit{ n >> 1 };
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(data[i], data[j]);
+        }
+
+        std::vector<std::uint32_t> roots(n / 2);
+        for (std::size_t length{ 2 }; length <= n; length <<= 1)
+        {
+            std::uint32_t step{ powMod(nttGenerator, (modulus - 1) / length, Modulus) };
+            if (inverse)
+                step = powMod(step, modulus - 2, Modulus);
+
+            std::size_t half{ length / 2 };
+            roots[0] = 1;
+            for (std::size_t k{ 1 }; k < half; ++k)
+                roots[k] = static_cast<std::uint32_t>(roots[k - 1] * static_cast<std::uint64_t>(step) % modulus);
+
+            for (std::size_t start{ 0 }; start < n; start += length)
+            {
+                for (std::size_t k{ 0 }; k < half; ++k)
+                {
+                    std::uint32_t u{ data[start + k] };
+                    std::uint32_t v{ static_cast<std::uint32_t>(data[start + k + half] * static_cast<std::uint64_t>(roots[k]) % modulus) };
+                    data[start + k] = static_cast<std::uint32_t>((u + static_cast<std::uint64_t>(v)) % modulus);
+                    data[start + k + half] = static_cast<std::uint32_t>((u + modulus - v) % modulus);
+                }
+            }
+        }
+
+        if (inverse)
+        {
+            std::uint64_t nInverse{ powMod(n, modulus - 2, Modulus) };
+            for (std::uint32_t& value : data)
+                value = static_cast<std::uint32_t>(value * nInverse % modulus);
+        }
+    }
+
+    // Column sums of a * b mod Modulus, padded to length
+    template <std::uint32_t Modulus>
+    std::vector<std::uint32_t> convolve(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, std::size_t length)
+    {
+        std::vector<std::uint32_t> fa(length);
+        std::vector<std::uint32_t> fb(length);
+        for (std::size_t i{ 0 }; i < na; ++i)
+            fa[i] = a[i] % Modulus;
+        for (std::size_t i{ 0 }; i < nb; ++i)
+            fb[i] = b[i] % Modulus;
+
+        ntt<Modulus>(fa, false);
+        ntt<Modulus>(fb, false);
+        for (std::size_t i{ 0 }; i < length; ++i)
+            fa[i] = static_cast<std::uint32_t>(fa[i] * static_cast<std::uint64_t>(fb[i]) % Modulus);
+        ntt<Modulus>(fa, true);
+
+        return fa;
+    }
+
+    // result[0..na + nb) = a * b via three NTTs and Garner's CRT reconstruction
+    void multiplyNtt(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limb* result)
+    {
+        std::size_t length{ 1 };
+        while (length < na + nb)
+            length <<= 1;
+
+        std::vector<std::uint32_t> r0{ convolve<nttPrime0>(a, na, b, nb, length) };
+        std::vector<std::uint32_t> r1{ convolve<nttPrime1>(a, na, b, nb, length) };
+        std::vector<std::uint32_t> r2{ convolve<nttPrime2>(a, na, b, nb, length) };
+
+        constexpr std::uint64_t p0{ nttPrime0 };
+        constexpr std::uint64_t p1{ nttPrime1 };
+        constexpr std::uint64_t p2{ nttPrime2 };
+        const std::uint64_t p0InvModP1{ powMod(p0, p1 - 2, nttPrime1) };
+        const std::uint64_t p0InvModP2{ powMod(p0, p2 - 2, nttPrime2) };
+        const std::uint64_t p1InvModP2{ powMod(p1, p2 - 2, nttPrime2) };
+
+        unsigned __int128 carry{ 0 };
+        for (std::size_t k{ 0 }; k < na + nb; ++k)
+        {
+            std::uint64_t x0{ r0[k] };
+            std::uint64_t x1{ (r1[k] + p1 - x0 % p1) % p1 * p0InvModP1 % p1 };
+            std::uint64_t x2{ (r2[k] + p2 - x0 % p2) % p2 * p0InvModP2 % p2 };
+            x2 = (x2 + p2 - x1 % p2) % p2 * p1InvModP2 % p2;
+
+            unsigned __int128 column{ x0 + static_cast<unsigned __int128>(x1) * p0
+                                      + static_cast<unsigned __int128>(x2) * p0 * p1 + carry };
+            result[k] = static_cast<Limb>(column % base);
+            carry = column / base;
+        }
+    }
+
+    // result[0..na + nb) = a * b for operands of any size; result must start out zero
+    void multiply(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limb* result)
+    {
+        if (na < nb)
+        {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+
+        if (nb < karatsubaThreshold)
+        {
+            multiplySchoolbook(a, na, b, nb, result);
+            return;
+        }
+
+        if (nb >= nttThreshold && na + nb <= nttMaxLength)
+        {
+            multiplyNtt(a, na, b, nb, result);
+            return;
+        }
+
+        // Multiply the longer operand in nb-sized pieces so every Karatsuba call is square
+        std::vector<Limb> piece(nb);
+        std::vector<Limb> product(2 * nb);
+        for (std::size_t offset{ 0 }; offset < na; offset += nb)
+        {
+            std::size_t length{ std::min(nb, na - offset) };
+            std::fill(piece.begin(), piece.end(), 0);
+            std::copy(a + offset, a + offset + length, piece.begin());
+            std::fill(product.begin(), product.end(), 0);
+
+            multiplyKaratsuba(piece.data(), b, nb, product.data());
+            addInto(result + offset, na + nb - offset, product.data(), trimmedSize(product.data(), product.size()));
+        }
+    }
+
+    // lo * (lo + 1) * ... * hi, splitting the range in half so both halves of each
+    // multiply are about the same size (which is where Karatsuba pays off)
+    BigUnsigned productRange(std::uint32_t lo, std::uint32_t hi)
+    {
+        if (hi - lo < 16)
+        {
+            BigUnsigned product{ lo };
+            for (std::uint32_t i{ lo + 1 }; i <= hi && i > lo; ++i)
+                product *= i;
+            return product;
+        }
+
+        std::uint32_t mid{ lo + (hi - lo) / 2 };
+        return productRange(lo, mid) * productRange(mid + 1, hi);
+    }
+}
+
+BigUnsigned::BigUnsigned(std::uint64_t value)
+{
+    while (value > 0)
+    {
+        m_limbs.push_back(static_cast<Limb>(value % base));
+        value /= base;
+    }
+}
+
+std::size_t BigUnsigned::digitCount() const
+{
+    if (m_limbs.empty())
+        return 1;
+
+    std::size_t digits{ (m_limbs.size() - 1) * digitsPerLimb };
+    for (Limb top{ m_limbs.back() }; top > 0; top /= 10)
+        ++digits;
+    return digits;
+}
+
+std::string BigUnsigned::toString() const
+{
+    if (m_limbs.empty())
+        return "0";
+
+    std::string text(digitCount(), '0');
+    std::size_t position{ text.size() };
+
+    // Every limb but the most significant is exactly nine digits, zero-padded
+    for (std::size_t i{ 0 }; i < m_limbs.size(); ++i)
+    {
+        Limb limb{ m_limbs[i] };
+        bool top{ i + 1 == m_limbs.size() };
+        for (int d{ 0 }; d < digitsPerLimb && (!top || limb > 0); ++d)
+        {
+            text[--position] = static_cast<char>('0' + limb % 10);
+            limb /= 10;
+        }
+    }
+
+    return text;
+}
+
+BigUnsigned& BigUnsigned::operator*=(Limb small)
+{
+    std::uint64_t carry{ 0 };
+    for (Limb& limb : m_limbs)
+    {
+        std::uint64_t current{ static_cast<std::uint64_t>(limb) * small + carry };
+        limb = static_cast<Limb>(current % base);
+        carry = current / base;
+    }
+    while (carry > 0)
+    {
+        m_limbs.push_back(static_cast<Limb>(carry % base));
+        carry /= base;
+    }
+
+    m_limbs.resize(trimmedSize(m_limbs.data(), m_limbs.size()));
+    return *this;
+}
+
+BigUnsigned& BigUnsigned::operator+=(const BigUnsigned& other)
+{
+    m_limbs.resize(std::max(m_limbs.size(), other.m_limbs.size()) + 1);
+    addInto(m_limbs.data(), m_limbs.size(), other.m_limbs.data(), other.m_limbs.size());
+    m_limbs.resize(trimmedSize(m_limbs.data(), m_limbs.size()));
+    return *this;
+}
+
+BigUnsigned operator+(const BigUnsigned& a, const BigUnsigned& b)
+{
+    BigUnsigned result{ a };
+    return result += b;
+}
+
+BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b)
+{
+    BigUnsigned result{};
+    if (a.isZero() || b.isZero())
+        return result;
+
+    result.m_limbs.resize(a.m_limbs.size() + b.m_limbs.size());
+    multiply(a.m_limbs.data(), a.m_limbs.size(), b.m_limbs.data(), b.m_limbs.size(), result.m_limbs.data());
+    result.m_limbs.resize(trimmedSize(result.m_limbs.data(), result.m_limbs.size()));
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& out, const BigUnsigned& value)
+{
+    out << value.toString();
+    return out;
+}
+
+BigUnsigned factorial(std::uint32_t n)
+{
+    if (n <= maxFactorial64)
+        return factorialTable[n];
+
+    return productRange(1, n);
+}
@@ -0,0 +1,75 @@
+// Header file that defines the BigUnsigned class and the factorial functions
+//
+// BigUnsigned is an arbitrary-precision non-negative integer stored in base 10^9
+// limbs (nine decimal digits per std::uint32_t), so printing it is a straight copy of
+// digits rather than a long division. Large products use Karatsuba multiplication.
+
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept> // for std::out_of_range
+#include <string>
+#include <vector>
+
+class BigUnsigned
+{
+public:
+    using Limb = std::uint32_t;
+    static constexpr Limb base{ 1'000'000'000 };
+    static constexpr int digitsPerLimb{ 9 };
+
+private:
+    std::vector<Limb> m_limbs{}; // least significant first, no leading zero limbs; 0 is empty
+
+public:
+    BigUnsigned(std::uint64_t value = 0);
+
+    bool isZero() const { return m_limbs.empty(); }
+
+    // Number of decimal digits (1 for zero)
+    std::size_t digitCount() const;
+
+    std::string toString() const;
+
+    BigUnsigned& operator*=(Limb small);
+    BigUnsigned& operator+=(const BigUnsigned& other);
+
+    friend BigUnsigned operator+(const BigUnsigned& a, const BigUnsigned& b);
+    friend BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b);
+
+    friend bool operator==(const BigUnsigned& a, const BigUnsigned& b) { return a.m_limbs == b.m_limbs; }
+    friend bool operator!=(const BigUnsigned& a, const BigUnsigned& b) { return !(a == b); }
+
+    friend std::ostream& operator<<(std::ostream& out, const BigUnsigned& value);
+};
+
+// Every factorial that fits in 64 bits, 0! through 20!, computed at compile time
+constexpr int maxFactorial64{ 20 };
+
+constexpr std::array<std::uint64_t, maxFactorial64 + 1> makeFactorialTable()
+{
+    std::array<std::uint64_t, maxFactorial64 + 1> table{};
+    table[0] = 1;
+    for (int n{ 1 }; n <= maxFactorial64; ++n)
+        table[n] = table[n - 1] * static_cast<std::uint64_t>(n);
+    return table;
+}
+
+constexpr std::array<std::uint64_t, maxFactorial64 + 1> factorialTable{ makeFactorialTable() };
+
+// n! for 0 <= n <= 20
+constexpr std::uint64_t factorial64(int n)
+{
+    if (n < 0 || n > maxFactorial64)
+        throw std::out_of_range{ "factorial64 only covers 0! to 20!" };
+    return factorialTable[static_cast<std::size_t>(n)];
+}
+
+// Exact n!, from the table for n <= 20 and by binary splitting above that
+BigUnsigned factorial(std::uint32_t n);
+
+#endif
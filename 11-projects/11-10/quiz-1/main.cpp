@@ -1,24 +1,10 @@
+#include <chrono>
 #include <iostream>
+#include "bignum.h"
 
-int factorial(int n)
-{
-    if (n <= 0)
-    {
-        // handle zero and negative input by returning zero
-        return 0;
-    }
-    else if (n == 1)
-    {
-        // base case
-        return 1;
-    }
-    else
-    {
-        // recursive call
-        return n * factorial(n - 1);
-    }
-    
-}
+// 0! through 20! come straight from the compile-time table
+static_assert(factorial64(0) == 1);
+static_assert(factorial64(20) == 2'432'902'008'176'640'000);
 
 int main()
 {
@@ -27,6 +13,13 @@ int main()
         std::cout << factorial(iii) << '\n';
     }
 
+    std::cout << "25! = " << factorial(25) << '\n';
+
+    auto start{ std::chrono::steady_clock::now() };
+    BigUnsigned big{ factorial(100'000) };
+    std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+    std::cout << "100000! has " << big.digitCount() << " digits (" << elapsed.count() << "s)\n";
+
     return 0;
 
-}
\ No newline at end of file
+}
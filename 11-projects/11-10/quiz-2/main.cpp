@@ -1,16 +1,10 @@
 #include <iostream>
+#include "../quiz-3/radix.h"
 
+// Used to recurse once per decimal digit; radix::digitSum() handles two per step
 int sumDigits(int input)
 {
-    if (input < 10)
-    {
-        return input;
-    }
-    else
-    {
-        return sumDigits(input / 10 ) + (input % 10);
-    }
-
+    return radix::digitSum(static_cast<std::uint64_t>(input));
 }
 
 int main()
@@ -1,22 +1,20 @@
 #include <iostream>
+#include "radix.h"
 
+// Both used to recurse once per bit and send each digit to std::cout on its own.
+// Now the digits are written into a buffer in one go and printed with a single write.
 void printBinary(int input)
 {
-    if (input == 0)
-    {
-        return;
-    }
-    printBinary(input / 2);
-    std::cout << input % 2;
+    char buffer[radix::maxBinaryChars<unsigned int>];
+    char* end{ radix::writeBinaryTrimmed(buffer, static_cast<unsigned int>(input)) };
+    std::cout.write(buffer, end - buffer);
 }
 
 void printBinaryUnsigned(unsigned int input)
 {
-    if (input > 1)
-    {
-        printBinaryUnsigned( input / 2 );
-    }
-    std::cout << input % 2 ;
+    char buffer[radix::maxBinaryChars<unsigned int>];
+    char* end{ radix::writeBinaryTrimmed(buffer, input) };
+    std::cout.write(buffer, end - buffer);
 }
 
 int main()
@@ -32,5 +30,9 @@ int main()
     {
         printBinary(x);
     }
+    std::cout << '\n';
+
+    std::cout << radix::toHexString(static_cast<unsigned int>(x)) << " has "
+              << radix::popcount(static_cast<unsigned int>(x)) << " bits set\n";
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,207 @@
+// Header file with fast radix conversion into caller-provided buffers
+//
+// Binary output turns 8 bits into 8 ASCII bytes with a handful of 64-bit word
+// operations (SWAR: SIMD within a register), hex and decimal output use small lookup
+// tables, and nothing goes through std::cout a character at a time. None of the
+// write functions null-terminate; each returns one past the last character written.
+
+#ifndef RADIX_H
+#define RADIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy()
+#include <string>
+#include <type_traits>
+
+namespace radix
+{
+    namespace detail
+    {
+        // Spreads the 8 bits of byte into 8 ASCII '0'/'1' characters, most significant first
+        inline std::uint64_t binaryChars(std::uint8_t byte)
+        {
+            // Copy the byte into every lane, then keep bit j in lane j
+            std::uint64_t lanes{ (byte * 0x0101010101010101ULL) & 0x8040201008040201ULL };
+            // Each lane is now 0 or a single bit; adding 0x7F sets the lane's high bit iff it was set
+            std::uint64_t bits{ ((lanes + 0x7F7F7F7F7F7F7F7FULL) & 0x8080808080808080ULL) >> 7 };
+            // Lane 0 holds bit 0 but must be printed last, so reverse the lanes in memory
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            bits = __builtin_bswap64(bits);
+#endif
+            return bits | 0x3030303030303030ULL;
+        }
+
+        struct Tables
+        {
+            char hexPairs[512]{};     // "00", "01", ..., "ff"
+            char decimalPairs[200]{}; // "00", "01", ..., "99"
+            std::uint8_t digitSums[100]{};
+
+            constexpr Tables()
+            {
+                constexpr char hexDigits[]{ "0123456789abcdef" };
+                for (int i{ 0 }; i < 256; ++i)
+                {
+                    hexPairs[i * 2] = hexDigits[i >> 4];
+                    hexPairs[i * 2 + 1] = hexDigits[i & 15];
+                }
+                for (int i{ 0 }; i < 100; ++i)
+                {
+                    decimalPairs[i * 2] = static_cast<char>('0' + i / 10);
+                    decimalPairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
+                    digitSums[i] = static_cast<std::uint8_t>(i / 10 + i % 10);
+                }
+            }
+        };
+
+        inline constexpr Tables tables{};
+
+        template <typename UInt>
+        constexpr void checkUnsigned()
+        {
+            static_assert(std::is_integral_v<UInt> && std::is_unsigned_v<UInt>, "radix functions take unsigned integers");
+        }
+    }
+
+    // Longest output of each writer for UInt
+    template <typename UInt>
+    constexpr std::size_t maxBinaryChars{ sizeof(UInt) * 8 };
+    template <typename UInt>
+    constexpr std::size_t maxHexChars{ sizeof(UInt) * 2 };
+    constexpr std::size_t maxDecimalChars{ 20 };
+
+    // All sizeof(UInt) * 8 bits, zero-padded: writeBinary(out, std::uint8_t{ 5 }) is "00000101"
+    template <typename UInt>
+    char* writeBinary(char* out, UInt value)
+    {
+        detail::checkUnsigned<UInt>();
+        for (int shift{ static_cast<int>(sizeof(UInt) * 8) - 8 }; shift >= 0; shift -= 8)
+        {
+            std::uint64_t chars{ detail::binaryChars(static_cast<std::uint8_t>(value >> shift)) };
+            std::memcpy(out, &chars, 8);
+            out += 8;
+        }
+        return out;
+    }
+
+    // Binary without leading zeros ("0" for zero): writeBinaryTrimmed(out, 5u) is "101"
+    template <typename UInt>
+    char* writeBinaryTrimmed(char* out, UInt value)
+    {
+        detail::checkUnsigned<UInt>();
+        if (value == 0)
+        {
+            *out = '0';
+            return out + 1;
+        }
+
+        char buffer[maxBinaryChars<UInt>];
+        writeBinary(buffer, value);
+
+        int leadingZeros{ __builtin_clzll(static_cast<unsigned long long>(value)) - (64 - static_cast<int>(sizeof(UInt) * 8)) };
+        std::size_t length{ sizeof(UInt) * 8 - static_cast<std::size_t>(leadingZeros) };
+        std::memcpy(out, buffer + leadingZeros, length);
+        return out + length;
+    }
+
+    // All sizeof(UInt) * 2 lowercase hex digits, zero-padded
+    template <typename UInt>
+    char* writeHex(char* out, UInt value)
+    {
+        detail::checkUnsigned<UInt>();
+        for (int shift{ static_cast<int>(sizeof(UInt) * 8) - 8 }; shift >= 0; shift -= 8)
+        {
+            std::memcpy(out, &detail::tables.hexPairs[static_cast<std::uint8_t>(value >> shift) * 2], 2);
+            out += 2;
+        }
+        return out;
+    }
+
+    // Decimal without leading zeros, two digits per table lookup
+    inline char* writeDecimal(char* out, std::uint64_t value)
+    {
+        char buffer[maxDecimalChars];
+        char* end{ buffer + maxDecimalChars };
+        char* p{ end };
+
+        while (value >= 100)
+        {
+            p -= 2;
+            std::memcpy(p, &detail::tables.decimalPairs[(value % 100) * 2], 2);
+            value /= 100;
+        }
+        if (value >= 10)
+        {
+            p -= 2;
+            std::memcpy(p, &detail::tables.decimalPairs[value * 2], 2);
+        }
+        else
+            *--p = static_cast<char>('0' + value);
+
+        std::size_t length{ static_cast<std::size_t>(end - p) };
+        std::memcpy(out, p, length);
+        return out + length;
+    }
+
+    // Multi-word (big) integers: words[0] is the least significant 64 bits.
+    // Writes count * 64 binary digits, most significant first.
+    inline char* writeBinary(char* out, const std::uint64_t* words, std::size_t count)
+    {
+        for (std::size_t i{ count }; i > 0; --i)
+            out = writeBinary(out, words[i - 1]);
+        return out;
+    }
+
+    // Writes count * 16 hex digits, most significant first
+    inline char* writeHex(char* out, const std::uint64_t* words, std::size_t count)
+    {
+        for (std::size_t i{ count }; i > 0; --i)
+            out = writeHex(out, words[i - 1]);
+        return out;
+    }
+
+    // Convenience wrappers for when an std::string is wanted anyway
+    template <typename UInt>
+    std::string toBinaryString(UInt value)
+    {
+        char buffer[maxBinaryChars<UInt>];
+        return std::string(buffer, writeBinaryTrimmed(buffer, value));
+    }
+
+    template <typename UInt>
+    std::string toHexString(UInt value)
+    {
+        char buffer[maxHexChars<UInt>];
+        return std::string(buffer, writeHex(buffer, value));
+    }
+
+    // Sum of the decimal digits of value, two digits per table lookup
+    inline int digitSum(std::uint64_t value)
+    {
+        int sum{ 0 };
+        while (value > 0)
+        {
+            sum += detail::tables.digitSums[value % 100];
+            value /= 100;
+        }
+        return sum;
+    }
+
+    // Sum of the binary digits: one instruction on CPUs with POPCNT
+    inline int popcount(std::uint64_t value)
+    {
+        return __builtin_popcountll(value);
+    }
+
+    // Total number of set bits in words[0..count)
+    inline std::uint64_t popcount(const std::uint64_t* words, std::size_t count)
+    {
+        std::uint64_t total{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+            total += static_cast<std::uint64_t>(__builtin_popcountll(words[i]));
+        return total;
+    }
+}
+
+#endif
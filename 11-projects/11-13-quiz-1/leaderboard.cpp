@@ -0,0 +1,212 @@
+// Member functions of the Leaderboard class defined here
+
+#include "leaderboard.h"
+
+#include <algorithm> // for std::min(), std::max(), std::push_heap(), std::pop_heap()
+#include <stdexcept> // for std::invalid_argument, std::overflow_error
+#include <thread>
+#include <utility> // for std::move()
+
+namespace
+{
+    // load() only splits work of at least this many items between threads
+    constexpr std::size_t parallelMinimum{ 1 << 14 };
+}
+
+void Leaderboard::siftUp(std::size_t position)
+{
+    Node node{ m_heap[position] };
+    while (position > 0)
+    {
+        std::size_t parent{ (position - 1) / 2 };
+        if (!above(node, m_heap[parent]))
+            break;
+        place(position, m_heap[parent]);
+        position = parent;
+    }
+    place(position, node);
+}
+
+void Leaderboard::siftDown(std::size_t position)
+{
+    Node node{ m_heap[position] };
+    std::size_t count{ m_heap.size() };
+    for (;;)
+    {
+        std::size_t child{ 2 * position + 1 };
+        if (child >= count)
+            break;
+        if (child + 1 < count && above(m_heap[child + 1], m_heap[child]))
+            ++child;
+        if (!above(m_heap[child], node))
+            break;
+        place(position, m_heap[child]);
+        position = child;
+    }
+    place(position, node);
+}
+
+void Leaderboard::set(std::string_view name, int score)
+{
+    if (const PlayerId* id{ m_ids.find(name) })
+    {
+        std::size_t position{ m_players[*id].node };
+        int oldScore{ m_heap[position].score };
+        m_heap[position].score = score;
+        if (score > oldScore)
+            siftUp(position);
+        else
+            siftDown(position);
+        return;
+    }
+
+    PlayerId id{ static_cast<PlayerId>(m_players.size()) };
+    m_players.push_back({ std::string{ name }, m_heap.size() });
+    m_heap.push_back({ score, id, m_nextJoined++ });
+    m_ids[name] = id;
+    siftUp(m_heap.size() - 1);
+}
+
+void Leaderboard::add(std::string_view name, int points)
+{
+    const PlayerId* id{ m_ids.find(name) };
+    int score{};
+    if (__builtin_add_overflow(id ? m_heap[m_players[*id].node].score : 0, points, &score))
+        throw std::overflow_error{ "Leaderboard::add: score overflow" };
+    set(name, score);
+}
+
+bool Leaderboard::erase(std::string_view name)
+{
+    const PlayerId* found{ m_ids.find(name) };
+    if (!found)
+        return false;
+    PlayerId id{ *found };
+    m_ids.erase(name); // before name can be invalidated below, if it points at our copy
+
+    // Fill the hole in the heap with the last node
+    std::size_t position{ m_players[id].node };
+    Node last{ m_heap.back() };
+    m_heap.pop_back();
+    if (position < m_heap.size())
+    {
+        place(position, last);
+        if (position > 0 && above(last, m_heap[(position - 1) / 2]))
+            siftUp(position);
+        else
+            siftDown(position);
+    }
+
+    // Fill the hole in m_players with the last player. Ties are broken by when the
+    // players joined, not by id, so changing its id doesn't move it in the heap.
+    PlayerId lastId{ static_cast<PlayerId>(m_players.size() - 1) };
+    if (id != lastId)
+    {
+        m_players[id] = std::move(m_players[lastId]);
+        m_heap[m_players[id].node].player = id;
+        m_ids[m_players[id].name] = id;
+    }
+    m_players.pop_back();
+    return true;
+}
+
+std::optional<int> Leaderboard::score(std::string_view name) const
+{
+    if (const PlayerId* id{ m_ids.find(name) })
+        return m_heap[m_players[*id].node].score;
+    return std::nullopt;
+}
+
+std::vector<Leaderboard::Entry> Leaderboard::top(std::size_t k) const
+{
+    k = std::min(k, m_heap.size());
+    std::vector<Entry> best;
+    best.reserve(k);
+    if (k == 0)
+        return best;
+
+    // Every node in the answer has its parent in the answer too, so the next best is
+    // always among the children of the nodes taken so far
+    auto lower{ [this](std::size_t a, std::size_t b) { return above(m_heap[b], m_heap[a]); } };
+    std::vector<std::size_t> frontier{ 0 };
+    frontier.reserve(k + 1);
+    while (best.size() < k)
+    {
+        std::pop_heap(frontier.begin(), frontier.end(), lower);
+        std::size_t position{ frontier.back() };
+        frontier.pop_back();
+
+        const Node& node{ m_heap[position] };
+        best.push_back({ m_players[node.player].name, node.score });
+
+        for (std::size_t child{ 2 * position + 1 }; child <= 2 * position + 2 && child < m_heap.size(); ++child)
+        {
+            frontier.push_back(child);
+            std::push_heap(frontier.begin(), frontier.end(), lower);
+        }
+    }
+    return best;
+}
+
+void Leaderboard::load(const std::vector<Entry>& entries, unsigned threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    // Build into a fresh board, so a duplicate name leaves this one as it was.
+    // The hash map is filled on this thread...
+    Leaderboard fresh;
+    std::size_t count{ entries.size() };
+    fresh.m_ids.reserve(count);
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        PlayerId& id{ fresh.m_ids[entries[i].name] };
+        if (fresh.m_ids.size() == i) // the name was already there
+            throw std::invalid_argument{ "Leaderboard::load: duplicate name " + std::string{ entries[i].name } };
+        id = static_cast<PlayerId>(i);
+    }
+
+    // ...while the players and nodes, and then each level of the heap, are split
+    // between threads
+    auto inParallel{ [threadCount](std::size_t first, std::size_t last, auto work) {
+        std::size_t items{ last - first };
+        unsigned threads{ items >= parallelMinimum ? threadCount : 1 };
+        auto range{ [&](unsigned t) {
+            for (std::size_t i{ first + items * t / threads }; i < first + items * (t + 1) / threads; ++i)
+                work(i);
+        } };
+
+        std::vector<std::thread> workers;
+        for (unsigned t{ 1 }; t < threads; ++t)
+            workers.emplace_back(range, t);
+        range(0);
+        for (std::thread& worker : workers)
+            worker.join();
+    } };
+
+    fresh.m_players.resize(count);
+    fresh.m_heap.resize(count);
+    inParallel(0, count, [&](std::size_t i) {
+        fresh.m_players[i] = { std::string{ entries[i].name }, i };
+        fresh.m_heap[i] = { entries[i].score, static_cast<PlayerId>(i), i };
+    });
+    fresh.m_nextJoined = count;
+
+    // Floyd's heap construction, one level at a time from the bottom. Nodes 0..count/2
+    // have children; level L holds nodes 2^L - 1 to 2^(L+1) - 2.
+    std::size_t levelStart{ 0 };
+    while (2 * levelStart + 1 < count / 2)
+        levelStart = 2 * levelStart + 1;
+    for (;;)
+    {
+        std::size_t levelEnd{ std::min(2 * levelStart + 1, count / 2) };
+        if (levelEnd > levelStart)
+            inParallel(levelStart, levelEnd, [&](std::size_t position) { fresh.siftDown(position); });
+
+        if (levelStart == 0)
+            break;
+        levelStart = (levelStart - 1) / 2;
+    }
+
+    *this = std::move(fresh);
+}
@@ -0,0 +1,101 @@
+// Header file that defines the Leaderboard class
+//
+// Keeps players ordered by score while scores keep changing, so the best players can
+// be read at any moment without scanning everyone.
+//
+// The players sit in a binary max-heap of (score, player) nodes. Each player
+// remembers its node's position, and a hash map finds a player from its name. That
+// makes an update one lookup and one sift up or down, O(log n). The best player is
+// always the root. The top k come from a small frontier of nodes: take the best one,
+// then add its two children.
+//
+// load() replaces everything in one go. It builds the heap bottom-up (Floyd's
+// method, O(n)), and the nodes on each level are sifted down by several threads at
+// once, because their subtrees don't overlap.
+
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../13-projects/13-9/stringmap.h"
+
+class Leaderboard
+{
+public:
+    struct Entry
+    {
+        std::string_view name;
+        int score;
+    };
+
+private:
+    using PlayerId = std::uint32_t;
+
+    struct Player
+    {
+        std::string name;
+        std::size_t node; // position in m_heap
+    };
+
+    // The score is kept in the node, so comparisons don't have to visit the player.
+    // So is when the player joined: ids are reused after erase(), so they can't say.
+    struct Node
+    {
+        int score;
+        PlayerId player;
+        std::uint64_t joined; // counts up from 0, one per player added
+    };
+
+    std::vector<Player> m_players{};
+    std::vector<Node> m_heap{};
+    StringMap<PlayerId> m_ids{};
+    std::uint64_t m_nextJoined{};
+
+    // Higher scores first; ties go to whoever joined first
+    static bool above(const Node& a, const Node& b)
+    {
+        return a.score != b.score ? a.score > b.score : a.joined < b.joined;
+    }
+
+    void place(std::size_t position, const Node& node)
+    {
+        m_heap[position] = node;
+        m_players[node.player].node = position;
+    }
+
+    void siftUp(std::size_t position);
+    void siftDown(std::size_t position);
+
+public:
+    std::size_t size() const { return m_players.size(); }
+    bool empty() const { return m_players.empty(); }
+
+    // Adds a player, or changes the score of one already here
+    void set(std::string_view name, int score);
+
+    // Adds points to a player's score (a new player starts from 0). Throws
+    // std::overflow_error, leaving the board as it was, if the score won't fit in an int.
+    void add(std::string_view name, int points);
+
+    // Returns whether the player was here
+    bool erase(std::string_view name);
+
+    // Returns nothing if the player isn't here
+    std::optional<int> score(std::string_view name) const;
+
+    // The best k players (fewer if there aren't k), best first; the names are good
+    // until the board next changes. O(k log k): only the nodes next to the ones
+    // already taken are looked at.
+    std::vector<Entry> top(std::size_t k) const;
+
+    // Replaces the whole board. Uses threadCount threads, or one per hardware thread
+    // if it's 0. Throws std::invalid_argument if a name appears twice.
+    void load(const std::vector<Entry>& entries, unsigned threadCount = 0);
+};
+
+#endif
@@ -2,6 +2,8 @@
 #include <string>
 #include <array>
 #include <algorithm>
+#include <vector>
+#include "leaderboard.h"
 
 struct Student
 {
@@ -36,5 +38,21 @@ int main()
     
     std::cout << best_student->name << " is the best student\n";
 
+    // max_element has to look at every student each time we ask. When scores keep
+    // changing, a Leaderboard keeps them ordered, so the best few are always ready
+    std::vector<Leaderboard::Entry> entries{};
+    for (const auto& student : arr)
+        entries.push_back({ student.name, student.score });
+
+    Leaderboard board{};
+    board.load(entries);
+
+    board.add("Christine", 7); // Christine now has 9 points
+    board.set("Dan", 4);
+
+    std::cout << "Top 3:\n";
+    for (const auto& entry : board.top(3))
+        std::cout << "  " << entry.name << " (" << entry.score << ")\n";
+
     return 0;
 }
\ No newline at end of file
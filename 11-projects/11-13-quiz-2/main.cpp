@@ -1,8 +1,8 @@
-#include <algorithm>
 #include <array>
 #include <iostream>
 #include <string_view>
 #include <string>
+#include "../../9-projects/quiz-2/keysort.h"
  
 struct Season
 {
@@ -19,11 +19,8 @@ int main()
         { "Winter", 263.0 } }
     };
  
-    std::sort(seasons.begin(), seasons.end(), 
-        [](const auto &a, const auto &b){
-            return a.averageTemperature < b.averageTemperature;
-        }
-    );
+    // radix sort on the temperature, pulled out of each season once
+    sortByKey(seasons, [](const Season& season) { return season.averageTemperature; });
  
   for (const auto& season : seasons)
   {
@@ -0,0 +1,165 @@
+// Contention benchmark for ConcurrentStack and SpscRing
+//
+// Build: g++ -std=c++17 -O2 -pthread benchmark.cpp -o benchmark
+//
+// Every thread count does the same total work, so the columns compare directly:
+// each thread pushes and pops its share of the pairs on one shared stack.
+
+#include "concurrentstack.h"
+#include "spscring.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory> // for std::make_unique()
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int totalPairs{ 2'000'000 };
+
+    // The baseline: a std::vector behind a mutex
+    class MutexStack
+    {
+    private:
+        std::mutex m_mutex{};
+        std::vector<int> m_values{};
+
+    public:
+        void push(int value)
+        {
+            std::lock_guard lock{ m_mutex };
+            m_values.push_back(value);
+        }
+
+        std::optional<int> pop()
+        {
+            std::lock_guard lock{ m_mutex };
+            if (m_values.empty())
+                return std::nullopt;
+            int value{ m_values.back() };
+            m_values.pop_back();
+            return value;
+        }
+    };
+
+    template <typename Work>
+    double secondsFor(Work work)
+    {
+        auto start{ std::chrono::steady_clock::now() };
+        work();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Millions of push/pop pairs per second with threadCount threads hammering one stack
+    template <typename Stack>
+    double stackThroughput(int threadCount)
+    {
+        Stack stack;
+        int pairsPerThread{ totalPairs / threadCount };
+        std::atomic<int> popped{ 0 };
+
+        double seconds{ secondsFor([&]() {
+            std::vector<std::thread> threads;
+            for (int t{ 0 }; t < threadCount; ++t)
+            {
+                threads.emplace_back([&stack, &popped, pairsPerThread, t]() {
+                    // every pop follows a push of our own, so the stack is never empty here
+                    int count{ 0 };
+                    for (int i{ 0 }; i < pairsPerThread; ++i)
+                    {
+                        stack.push(t + i);
+                        if (stack.pop())
+                            ++count;
+                    }
+                    popped += count;
+                });
+            }
+            for (std::thread& thread : threads)
+                thread.join();
+        }) };
+
+        if (popped != pairsPerThread * threadCount)
+            std::cout << "lost elements!\n";
+        return pairsPerThread * threadCount / seconds / 1e6;
+    }
+
+    // Millions of elements per second through one producer and one consumer
+    template <typename Push, typename Pop>
+    double pipeThroughput(Push push, Pop pop)
+    {
+        constexpr int count{ 10'000'000 };
+        long long sum{ 0 };
+
+        double seconds{ secondsFor([&]() {
+            std::thread producer{ [&]() {
+                for (int i{ 0 }; i < count; ++i)
+                {
+                    while (!push(i))
+                        std::this_thread::yield();
+                }
+            } };
+
+            for (int received{ 0 }; received < count;)
+            {
+                if (std::optional<int> value{ pop() })
+                {
+                    sum += *value;
+                    ++received;
+                }
+                else
+                    std::this_thread::yield();
+            }
+            producer.join();
+        }) };
+
+        if (sum != static_cast<long long>(count) * (count - 1) / 2)
+            std::cout << "lost elements!\n";
+        return count / seconds / 1e6;
+    }
+}
+
+int main()
+{
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout << "threads  lock-free stack  mutex stack  (M push/pop pairs per second)\n";
+    for (int threadCount : { 1, 2, 4, 8, 16, 32, 64 })
+    {
+        std::cout << threadCount << "\t "
+                  << stackThroughput<ConcurrentStack<int>>(threadCount) << "\t\t  "
+                  << stackThroughput<MutexStack>(threadCount) << '\n';
+    }
+
+    auto ring{ std::make_unique<SpscRing<int, 4096>>() };
+    double ringRate{ pipeThroughput(
+        [&ring](int value) { return ring->tryPush(value); },
+        [&ring]() { return ring->tryPop(); }) };
+
+    std::mutex mutex;
+    std::queue<int> queue;
+    double queueRate{ pipeThroughput(
+        [&](int value) {
+            std::lock_guard lock{ mutex };
+            if (queue.size() >= 4096)
+                return false;
+            queue.push(value);
+            return true;
+        },
+        [&]() -> std::optional<int> {
+            std::lock_guard lock{ mutex };
+            if (queue.empty())
+                return std::nullopt;
+            int value{ queue.front() };
+            queue.pop();
+            return value;
+        }) };
+
+    std::cout << "\nSPSC ring: " << ringRate << " M elements per second, mutex queue: " << queueRate << '\n';
+
+    return 0;
+}
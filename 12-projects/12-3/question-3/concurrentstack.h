@@ -0,0 +1,87 @@
+// Header file that defines the ConcurrentStack class template
+//
+// An unbounded lock-free stack (a Treiber stack): the stack is a linked list, and
+// push() and pop() swap the head pointer with a single compare-and-swap, retrying if
+// another thread got there first. Popped nodes are freed through hazard pointers, so
+// a node is never deleted (or reused, which would cause the ABA problem) while
+// another thread might still be reading it.
+
+#ifndef CONCURRENTSTACK_H
+#define CONCURRENTSTACK_H
+
+#include "hazardpointers.h"
+
+#include <atomic>
+#include <optional>
+#include <utility> // for std::move()
+
+template <typename T>
+class ConcurrentStack
+{
+private:
+    struct Node
+    {
+        T value;
+        Node* next;
+    };
+
+    // On its own cache line, away from whatever is stored next to the stack
+    alignas(64) std::atomic<Node*> m_head{ nullptr };
+
+public:
+    ConcurrentStack() = default;
+
+    // Only safe once no other thread is using the stack
+    ~ConcurrentStack()
+    {
+        Node* node{ m_head.load(std::memory_order_relaxed) };
+        while (node)
+        {
+            Node* next{ node->next };
+            delete node;
+            node = next;
+        }
+    }
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    void push(T value)
+    {
+        Node* node{ new Node{ std::move(value), m_head.load(std::memory_order_relaxed) } };
+        // release: a thread that pops this node must also see its value
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Returns the top value, or nothing if the stack was empty
+    std::optional<T> pop()
+    {
+        for (;;)
+        {
+            Node* top{ hazard::protect(m_head) };
+            if (!top)
+            {
+                hazard::clear();
+                return std::nullopt;
+            }
+
+            // top can't be freed while we protect it, so reading its next is safe.
+            // seq_cst pairs with protect(): either its re-load of m_head sees top is gone,
+            // or our scan() after retiring top is sure to see its hazard
+            if (m_head.compare_exchange_weak(top, top->next, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                hazard::clear();
+                std::optional<T> value{ std::move(top->value) };
+                hazard::retire(top);
+                return value;
+            }
+        }
+    }
+
+    // Just a snapshot: other threads may push or pop right after
+    bool empty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+};
+
+#endif
@@ -0,0 +1,183 @@
+// Header file for hazard pointers, the memory reclamation scheme ConcurrentStack uses
+//
+// A lock-free structure can't delete a node as soon as it unlinks it: another thread
+// may have loaded a pointer to that node a moment earlier and be about to read it.
+// With hazard pointers, a thread publishes ("protects") the pointer it is about to
+// use in a slot every thread can see. Unlinked nodes are "retired" instead of
+// deleted, and a retired node is only deleted once no slot holds it.
+
+#ifndef HAZARDPOINTERS_H
+#define HAZARDPOINTERS_H
+
+#include <algorithm> // for std::sort(), std::binary_search()
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept> // for std::runtime_error
+#include <vector>
+
+namespace hazard
+{
+    // Threads that can hold a hazard pointer at the same time
+    constexpr int maxThreads{ 256 };
+
+    namespace detail
+    {
+        // One slot per line, so threads publishing pointers don't slow each other down
+        struct alignas(64) Slot
+        {
+            std::atomic<bool> inUse{ false };
+            std::atomic<void*> pointer{ nullptr };
+        };
+
+        inline Slot slots[maxThreads];
+
+        struct Retired
+        {
+            void* pointer;
+            void (*deleter)(void*);
+        };
+
+        // Retired nodes left behind by threads that exited while they were still protected.
+        // Whatever is left at program exit is deleted then, when no thread can hold a hazard.
+        struct OrphanList
+        {
+            std::vector<Retired> nodes;
+
+            ~OrphanList()
+            {
+                for (Retired& node : nodes)
+                    node.deleter(node.pointer);
+            }
+        };
+
+        inline std::mutex orphansMutex;
+        inline OrphanList orphans;
+
+        // Deletes every retired node that no slot protects and keeps the rest
+        inline void scan(std::vector<Retired>& retired)
+        {
+            // Callers must unlink nodes with a seq_cst operation. With the seq_cst store then
+            // load in protect(), a thread that stored its hazard before the node was unlinked
+            // is seen below, and one that stored it after sees the node is gone when it
+            // re-loads the source and doesn't use it
+            std::vector<void*> hazards;
+            hazards.reserve(maxThreads);
+            for (Slot& slot : slots)
+            {
+                if (void* pointer{ slot.pointer.load(std::memory_order_seq_cst) })
+                    hazards.push_back(pointer);
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            std::size_t kept{ 0 };
+            for (Retired& node : retired)
+            {
+                if (std::binary_search(hazards.begin(), hazards.end(), node.pointer))
+                    retired[kept++] = node;
+                else
+                    node.deleter(node.pointer);
+            }
+            retired.resize(kept);
+        }
+
+        // The calling thread's slot and retired list, claimed on first use and
+        // handed back when the thread exits
+        class ThreadRecord
+        {
+        private:
+            Slot* m_slot{};
+            std::vector<Retired> m_retired{};
+
+        public:
+            ThreadRecord()
+            {
+                for (Slot& slot : slots)
+                {
+                    bool expected{ false };
+                    if (!slot.inUse.load(std::memory_order_relaxed)
+                        && slot.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    {
+                        m_slot = &slot;
+                        return;
+                    }
+                }
+                throw std::runtime_error{ "more than hazard::maxThreads threads are using hazard pointers" };
+            }
+
+            ~ThreadRecord()
+            {
+                m_slot->pointer.store(nullptr, std::memory_order_release);
+                scan(m_retired);
+
+                std::lock_guard lock{ orphansMutex };
+                orphans.nodes.insert(orphans.nodes.end(), m_retired.begin(), m_retired.end());
+                m_slot->inUse.store(false, std::memory_order_release);
+            }
+
+            ThreadRecord(const ThreadRecord&) = delete;
+            ThreadRecord& operator=(const ThreadRecord&) = delete;
+
+            Slot& slot() { return *m_slot; }
+
+            void retire(void* pointer, void (*deleter)(void*))
+            {
+                m_retired.push_back({ pointer, deleter });
+
+                // Scanning costs O(maxThreads), so wait until there is enough to amortize it;
+                // this also bounds the unreclaimed nodes per thread to about 2 * maxThreads
+                if (m_retired.size() >= 2 * static_cast<std::size_t>(maxThreads))
+                {
+                    {
+                        std::unique_lock lock{ orphansMutex, std::try_to_lock };
+                        if (lock && !orphans.nodes.empty())
+                        {
+                            m_retired.insert(m_retired.end(), orphans.nodes.begin(), orphans.nodes.end());
+                            orphans.nodes.clear();
+                        }
+                    }
+                    scan(m_retired);
+                }
+            }
+        };
+
+        inline ThreadRecord& threadRecord()
+        {
+            thread_local ThreadRecord record;
+            return record;
+        }
+    }
+
+    // Loads source and protects the result; once this returns, the node it points to
+    // won't be deleted until clear() (or the next protect()) on this thread
+    template <typename Node>
+    Node* protect(const std::atomic<Node*>& source)
+    {
+        std::atomic<void*>& hazard{ detail::threadRecord().slot().pointer };
+        Node* pointer{ source.load(std::memory_order_relaxed) };
+        for (;;)
+        {
+            // seq_cst so the store is visible before we re-check source, and so a
+            // scan() that runs after the node was unlinked is sure to see it
+            hazard.store(pointer, std::memory_order_seq_cst);
+            Node* current{ source.load(std::memory_order_seq_cst) };
+            if (current == pointer)
+                return pointer;
+            pointer = current;
+        }
+    }
+
+    inline void clear()
+    {
+        detail::threadRecord().slot().pointer.store(nullptr, std::memory_order_release);
+    }
+
+    // Hands over an unlinked node; it's deleted once no thread protects it
+    template <typename Node>
+    void retire(Node* node)
+    {
+        detail::threadRecord().retire(node, [](void* pointer) { delete static_cast<Node*>(pointer); });
+    }
+}
+
+#endif
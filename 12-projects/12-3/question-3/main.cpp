@@ -1,6 +1,9 @@
 #include <iostream>
 #include <array>
 #include <cassert>
+#include <thread>
+#include <vector>
+#include "concurrentstack.h"
 
 class Stack
 {
@@ -66,6 +69,19 @@ int main()
 	stack.pop();
  
 	stack.print();
+
+	// The concurrent version has no size limit and can be shared between threads
+	ConcurrentStack<int> shared;
+	std::vector<std::thread> pushers;
+	for (int t{ 0 }; t < 4; ++t)
+		pushers.emplace_back([&shared, t]() { for (int i{ 0 }; i < 1000; ++i) shared.push(t); });
+	for (std::thread& pusher : pushers)
+		pusher.join();
+
+	int total{ 0 };
+	while (std::optional<int> value{ shared.pop() })
+		total += *value;
+	std::cout << "popped total " << total << '\n'; // 1000 * (0 + 1 + 2 + 3)
  
 	return 0;
 }
\ No newline at end of file
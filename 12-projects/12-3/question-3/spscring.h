@@ -0,0 +1,91 @@
+// Header file that defines the SpscRing class template
+//
+// A bounded queue for exactly one producer thread and one consumer thread. With one
+// writer per index no compare-and-swap is needed: the producer only ever writes
+// m_tail and the consumer only m_head, each with a plain atomic store. The two
+// indices sit on separate cache lines so the threads don't keep stealing the same
+// line from each other (false sharing), and each side keeps a cached copy of the
+// other's index so it only reads the shared one when the ring looks full or empty.
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <utility> // for std::move()
+
+// Capacity must be a power of two so positions wrap with a mask instead of a division
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+private:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static constexpr std::size_t mask{ Capacity - 1 };
+    static constexpr std::size_t cacheLine{ 64 };
+
+    // Indices count up forever; index & mask is the slot. tail - head is the size.
+    alignas(cacheLine) std::atomic<std::size_t> m_head{ 0 }; // written by the consumer
+    std::size_t m_cachedTail{ 0 };                            // consumer's copy of m_tail
+
+    alignas(cacheLine) std::atomic<std::size_t> m_tail{ 0 }; // written by the producer
+    std::size_t m_cachedHead{ 0 };                            // producer's copy of m_head
+
+    alignas(cacheLine) alignas(T) unsigned char m_storage[Capacity * sizeof(T)];
+
+    T* slot(std::size_t index) { return reinterpret_cast<T*>(m_storage) + (index & mask); }
+
+public:
+    SpscRing() = default;
+
+    ~SpscRing()
+    {
+        while (tryPop())
+        {
+        }
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    // Producer only. Returns false if the ring is full.
+    bool tryPush(T value)
+    {
+        std::size_t tail{ m_tail.load(std::memory_order_relaxed) };
+        if (tail - m_cachedHead == Capacity)
+        {
+            // acquire: the consumer must be done with the slot before we reuse it
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity)
+                return false;
+        }
+
+        new (slot(tail)) T(std::move(value));
+        // release: publishes the element along with the new tail
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Returns nothing if the ring is empty.
+    std::optional<T> tryPop()
+    {
+        std::size_t head{ m_head.load(std::memory_order_relaxed) };
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return std::nullopt;
+        }
+
+        T* element{ slot(head) };
+        std::optional<T> value{ std::move(*element) };
+        element->~T();
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+};
+
+#endif
@@ -1,24 +1,13 @@
 #include <iostream>
+#include "smallstring.h"
  
 class HelloWorld
 {
 private:
-	char* m_data{};
+	// 13 characters fit inside the object, so there's nothing to allocate or delete
+	SmallString m_data{ "Hello, World!" };
  
 public:
-	HelloWorld()
-	{
-		m_data = new char[14];
-		const char* init{ "Hello, World!" };
-		for (int i = 0; i < 14; ++i)
-			m_data[i] = init[i];
-	}
- 
-	~HelloWorld()
-	{
-        delete[] m_data;
-	}
- 
 	void print() const
 	{
 		std::cout << m_data << '\n';
@@ -0,0 +1,246 @@
+// Header file that defines the SmallString class
+//
+// A string that keeps up to 23 characters inside the object itself (24 bytes, the
+// same as three pointers), so short strings such as names and identifiers never
+// allocate. Longer strings go to the heap.
+//
+// Layout: for a short string, bytes 0-22 hold the characters followed by zeros, and
+// byte 23 holds 23 - size. A 23-character string therefore ends in a 0 byte, which
+// doubles as its null terminator. For a heap string, bytes 0-7 hold the pointer,
+// bytes 8-15 the size, and byte 23 is heapMarker. The capacity is stored on the
+// heap, just before the characters.
+//
+// Construction from a string literal is constexpr. In C++17 a class with a
+// destructor can't be a constexpr variable, but a static SmallString initialized
+// from a literal is still set up at compile time, with no code run at startup.
+// Because the unused bytes are always zero, two short strings are equal exactly
+// when their three 8-byte words are.
+
+#ifndef SMALLSTRING_H
+#define SMALLSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy(), std::memcmp()
+#include <iostream>
+#include <string_view>
+#include <utility> // for std::move()
+
+class SmallString
+{
+public:
+    static constexpr std::size_t inlineCapacity{ 23 };
+
+private:
+    static constexpr unsigned char heapMarker{ 0xFF };
+    static constexpr std::size_t markerIndex{ 23 };
+
+    char m_buffer[24]{};
+
+    bool isHeap() const { return static_cast<unsigned char>(m_buffer[markerIndex]) == heapMarker; }
+
+    char* heapData() const
+    {
+        char* data;
+        std::memcpy(&data, m_buffer, sizeof(data));
+        return data;
+    }
+
+    std::size_t heapSize() const
+    {
+        std::size_t size;
+        std::memcpy(&size, m_buffer + 8, sizeof(size));
+        return size;
+    }
+
+    static std::size_t& capacityOf(char* data) { return *reinterpret_cast<std::size_t*>(data - sizeof(std::size_t)); }
+
+    // Room for capacity characters plus a terminator, with the capacity stored in front
+    static char* allocate(std::size_t capacity)
+    {
+        char* block{ new char[sizeof(std::size_t) + capacity + 1] };
+        char* data{ block + sizeof(std::size_t) };
+        capacityOf(data) = capacity;
+        return data;
+    }
+
+    static void deallocate(char* data) { delete[] (data - sizeof(std::size_t)); }
+
+    void setHeap(char* data, std::size_t size)
+    {
+        std::memcpy(m_buffer, &data, sizeof(data));
+        std::memcpy(m_buffer + 8, &size, sizeof(size));
+        m_buffer[markerIndex] = static_cast<char>(heapMarker);
+    }
+
+    void setInlineSize(std::size_t size) { m_buffer[markerIndex] = static_cast<char>(inlineCapacity - size); }
+
+    void assignHeap(std::string_view text)
+    {
+        char* data{ allocate(text.size()) };
+        std::memcpy(data, text.data(), text.size());
+        data[text.size()] = '\0';
+        setHeap(data, text.size());
+    }
+
+    // Only called on a fresh (empty) object. Reads through text.data() rather than
+    // text[i]: GCC won't run a static initializer at compile time if it goes through
+    // string_view's checked operator[].
+    constexpr void assign(std::string_view text)
+    {
+        if (text.size() <= inlineCapacity)
+        {
+            const char* characters{ text.data() };
+            for (std::size_t i{ 0 }; i < text.size(); ++i)
+                m_buffer[i] = characters[i];
+            m_buffer[markerIndex] = static_cast<char>(inlineCapacity - text.size());
+        }
+        else
+            assignHeap(text);
+    }
+
+    void release() noexcept
+    {
+        if (isHeap())
+            deallocate(heapData());
+    }
+
+public:
+    constexpr SmallString() noexcept
+    {
+        m_buffer[markerIndex] = static_cast<char>(inlineCapacity);
+    }
+
+    constexpr SmallString(std::string_view text)
+    {
+        assign(text);
+    }
+
+    // __builtin_strlen is folded at compile time for a literal and is the library's
+    // vectorized strlen at run time
+    constexpr SmallString(const char* text)
+    {
+        assign({ text, __builtin_strlen(text) });
+    }
+
+    SmallString(const SmallString& other)
+    {
+        if (other.isHeap())
+            assignHeap(other);
+        else
+            std::memcpy(m_buffer, other.m_buffer, sizeof(m_buffer));
+    }
+
+    SmallString(SmallString&& other) noexcept
+    {
+        std::memcpy(m_buffer, other.m_buffer, sizeof(m_buffer));
+        std::memset(other.m_buffer, 0, sizeof(other.m_buffer));
+        other.m_buffer[markerIndex] = static_cast<char>(inlineCapacity);
+    }
+
+    SmallString& operator=(const SmallString& other)
+    {
+        if (this != &other)
+        {
+            SmallString copy{ other };
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SmallString& operator=(SmallString&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            std::memcpy(m_buffer, other.m_buffer, sizeof(m_buffer));
+            std::memset(other.m_buffer, 0, sizeof(other.m_buffer));
+            other.m_buffer[markerIndex] = static_cast<char>(inlineCapacity);
+        }
+        return *this;
+    }
+
+    ~SmallString()
+    {
+        release();
+    }
+
+    std::size_t size() const
+    {
+        return isHeap() ? heapSize() : inlineCapacity - static_cast<unsigned char>(m_buffer[markerIndex]);
+    }
+
+    bool empty() const { return size() == 0; }
+    bool isInline() const { return !isHeap(); }
+
+    const char* data() const { return isHeap() ? heapData() : m_buffer; }
+    const char* c_str() const { return data(); }
+
+    operator std::string_view() const { return { data(), size() }; }
+
+    // Adds text to the end; it may point into this string
+    SmallString& append(std::string_view text)
+    {
+        std::size_t oldSize{ size() };
+        std::size_t newSize{ oldSize + text.size() };
+
+        if (!isHeap() && newSize <= inlineCapacity)
+        {
+            std::memmove(m_buffer + oldSize, text.data(), text.size());
+            setInlineSize(newSize);
+            return *this;
+        }
+
+        if (isHeap() && newSize <= capacityOf(heapData()))
+        {
+            char* data{ heapData() };
+            std::memmove(data + oldSize, text.data(), text.size());
+            data[newSize] = '\0';
+            setHeap(data, newSize);
+            return *this;
+        }
+
+        // Grow geometrically, and copy text before freeing the old buffer it may be in
+        std::size_t capacity{ newSize > 2 * oldSize ? newSize : 2 * oldSize };
+        char* data{ allocate(capacity) };
+        std::memcpy(data, this->data(), oldSize);
+        std::memcpy(data + oldSize, text.data(), text.size());
+        data[newSize] = '\0';
+        release();
+        setHeap(data, newSize);
+        return *this;
+    }
+
+    SmallString& operator+=(std::string_view text) { return append(text); }
+
+    friend bool operator==(const SmallString& a, const SmallString& b)
+    {
+        if (!a.isHeap() && !b.isHeap())
+        {
+            // All 24 bytes, size marker included, in three word compares
+            std::uint64_t x[3];
+            std::uint64_t y[3];
+            std::memcpy(x, a.m_buffer, sizeof(x));
+            std::memcpy(y, b.m_buffer, sizeof(y));
+            return ((x[0] ^ y[0]) | (x[1] ^ y[1]) | (x[2] ^ y[2])) == 0;
+        }
+        std::size_t size{ a.size() };
+        return size == b.size() && std::memcmp(a.data(), b.data(), size) == 0;
+    }
+
+    friend bool operator!=(const SmallString& a, const SmallString& b) { return !(a == b); }
+
+    friend bool operator<(const SmallString& a, const SmallString& b)
+    {
+        return std::string_view{ a } < std::string_view{ b };
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SmallString& s)
+    {
+        return out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+};
+
+static_assert(sizeof(SmallString) == 24, "SmallString should be the size of three pointers");
+
+#endif
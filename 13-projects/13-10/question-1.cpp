@@ -1,6 +1,8 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <cassert>
+#include "rope.h"
 
 class Mystring
 {
@@ -8,17 +10,15 @@ private:
     std::string m_string;
 public:
     Mystring(std::string string) : m_string{string} {}
-    std::string operator() (int start, int length) const
+
+    // Returns a view into m_string rather than a copy, so slicing never allocates.
+    // The view is only valid while this Mystring is alive and unchanged.
+    std::string_view operator() (int start, int length) const
     {
-        assert(start >= 0);
-        assert( (start + length) < static_cast<int>(m_string.length()) && "Mystring::operator(int, int): Substring is out of range");
+        assert(start >= 0 && length >= 0);
+        assert( (start + length) <= static_cast<int>(m_string.length()) && "Mystring::operator(int, int): Substring is out of range");
 
-        std::string out{};
-        for (int i{start}; i < (length + start); ++i)
-        {
-            out += m_string[i];
-        }
-        return out;
+        return std::string_view{ m_string }.substr(static_cast<std::size_t>(start), static_cast<std::size_t>(length));
     }
 };
 
@@ -26,6 +26,14 @@ int main()
 {
     Mystring string{ "Hello, world!" };
     std::cout << string(7, 5) << '\n'; // start at index 7 and return 5 characters
+    std::cout << string(7, 6) << '\n'; // a slice may end exactly at the end of the string
+
+    // For text that gets edited, a Rope avoids shifting everything after each edit
+    Rope document{ "Hello, world!" };
+    document.insert(7, "big ");
+    document.erase(0, 5);
+    document.insert(0, "Goodbye");
+    std::cout << document.toString() << " (\"world\" at " << document.find("world") << ")\n";
  
     return 0;
-}
\ No newline at end of file
+}
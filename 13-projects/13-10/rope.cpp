@@ -0,0 +1,306 @@
+// Member functions of the Rope class defined here
+
+#include "rope.h"
+
+#include <algorithm> // for std::min()
+#include <random>
+#include <stdexcept> // for std::out_of_range
+#include <vector>
+
+namespace
+{
+    std::uint32_t randomPriority()
+    {
+        thread_local std::minstd_rand generator{ std::random_device{}() };
+        return static_cast<std::uint32_t>(generator());
+    }
+}
+
+Rope::Node::Node(std::string_view chunk, std::uint32_t priority)
+    : text{ chunk }
+    , length{ chunk.size() }
+    , priority{ priority }
+{
+}
+
+void Rope::update(Node& node)
+{
+    node.length = lengthOf(node.left) + node.text.size() + lengthOf(node.right);
+}
+
+Rope::NodePtr Rope::build(std::string_view text)
+{
+    // Build the treap left to right in one pass (a Cartesian tree): the stack holds the
+    // right edge of the tree so far, and each new chunk pops the nodes with a lower
+    // priority off it and adopts them as its left subtree
+    std::vector<NodePtr> rightEdge{};
+    for (std::size_t start{ 0 }; start < text.size(); start += maxChunk)
+    {
+        NodePtr node{ std::make_unique<Node>(text.substr(start, maxChunk), randomPriority()) };
+
+        NodePtr last{};
+        while (!rightEdge.empty() && rightEdge.back()->priority < node->priority)
+        {
+            NodePtr popped{ std::move(rightEdge.back()) };
+            rightEdge.pop_back();
+            popped->right = std::move(last);
+            update(*popped);
+            last = std::move(popped);
+        }
+        node->left = std::move(last);
+        rightEdge.push_back(std::move(node));
+    }
+
+    NodePtr last{};
+    while (!rightEdge.empty())
+    {
+        NodePtr popped{ std::move(rightEdge.back()) };
+        rightEdge.pop_back();
+        popped->right = std::move(last);
+        update(*popped);
+        last = std::move(popped);
+    }
+    return last;
+}
+
+Rope::NodePtr Rope::clone(const Node* node)
+{
+    if (!node)
+        return nullptr;
+    NodePtr copy{ std::make_unique<Node>(node->text, node->priority) };
+    copy->left = clone(node->left.get());
+    copy->right = clone(node->right.get());
+    copy->length = node->length;
+    return copy;
+}
+
+std::pair<Rope::NodePtr, Rope::NodePtr> Rope::split(NodePtr node, std::size_t position)
+{
+    if (!node)
+        return {};
+
+    std::size_t leftLength{ lengthOf(node->left) };
+    std::size_t chunkEnd{ leftLength + node->text.size() };
+
+    if (position <= leftLength)
+    {
+        auto [front, back] = split(std::move(node->left), position);
+        node->left = std::move(back);
+        update(*node);
+        return { std::move(front), std::move(node) };
+    }
+    if (position >= chunkEnd)
+    {
+        auto [front, back] = split(std::move(node->right), position - chunkEnd);
+        node->right = std::move(front);
+        update(*node);
+        return { std::move(node), std::move(back) };
+    }
+
+    // The cut falls inside this chunk: the back half becomes a node of its own, with
+    // the same priority so both halves still outrank their children
+    std::size_t offset{ position - leftLength };
+    NodePtr back{ std::make_unique<Node>(std::string_view{ node->text }.substr(offset), node->priority) };
+    node->text.resize(offset);
+    back->right = std::move(node->right);
+    update(*back);
+    update(*node);
+    return { std::move(node), std::move(back) };
+}
+
+Rope::NodePtr Rope::merge(NodePtr a, NodePtr b)
+{
+    if (!a)
+        return b;
+    if (!b)
+        return a;
+
+    if (a->priority > b->priority)
+    {
+        a->right = merge(std::move(a->right), std::move(b));
+        update(*a);
+        return a;
+    }
+    b->left = merge(std::move(a), std::move(b->left));
+    update(*b);
+    return b;
+}
+
+bool Rope::insertInPlace(Node* node, std::size_t position, std::string_view text)
+{
+    if (!node)
+        return false;
+
+    std::size_t leftLength{ lengthOf(node->left) };
+    std::size_t chunkEnd{ leftLength + node->text.size() };
+
+    bool inserted{ false };
+    if (position < leftLength)
+        inserted = insertInPlace(node->left.get(), position, text);
+    else if (position > chunkEnd)
+        inserted = insertInPlace(node->right.get(), position - chunkEnd, text);
+    else if (node->text.size() + text.size() <= maxChunk)
+    {
+        node->text.insert(position - leftLength, text);
+        inserted = true;
+    }
+
+    if (inserted)
+        node->length += text.size();
+    return inserted;
+}
+
+Rope::Rope(std::string_view text)
+    : m_root{ build(text) }
+{
+}
+
+Rope::Rope(const Rope& other)
+    : m_root{ clone(other.m_root.get()) }
+{
+}
+
+Rope& Rope::operator=(const Rope& other)
+{
+    if (this != &other)
+        m_root = clone(other.m_root.get());
+    return *this;
+}
+
+char Rope::at(std::size_t position) const
+{
+    if (position >= size())
+        throw std::out_of_range{ "Rope::at: position is past the end" };
+
+    const Node* node{ m_root.get() };
+    for (;;)
+    {
+        std::size_t leftLength{ lengthOf(node->left) };
+        if (position < leftLength)
+            node = node->left.get();
+        else if (position < leftLength + node->text.size())
+            return node->text[position - leftLength];
+        else
+        {
+            position -= leftLength + node->text.size();
+            node = node->right.get();
+        }
+    }
+}
+
+void Rope::insert(std::size_t position, std::string_view text)
+{
+    if (position > size())
+        throw std::out_of_range{ "Rope::insert: position is past the end" };
+    if (text.empty())
+        return;
+
+    // Small edits go into an existing chunk when there is room, so typing a character
+    // at a time doesn't leave a trail of one-character nodes
+    if (text.size() < maxChunk && insertInPlace(m_root.get(), position, text))
+        return;
+
+    auto [front, back] = split(std::move(m_root), position);
+    m_root = merge(merge(std::move(front), build(text)), std::move(back));
+}
+
+void Rope::erase(std::size_t position, std::size_t count)
+{
+    if (position > size())
+        throw std::out_of_range{ "Rope::erase: position is past the end" };
+
+    auto [front, rest] = split(std::move(m_root), position);
+    auto [erased, back] = split(std::move(rest), count);
+    m_root = merge(std::move(front), std::move(back));
+    // erased is freed here
+}
+
+void Rope::append(Rope&& other)
+{
+    if (this != &other)
+        m_root = merge(std::move(m_root), std::move(other.m_root));
+}
+
+Rope Rope::splitOff(std::size_t position)
+{
+    if (position > size())
+        throw std::out_of_range{ "Rope::splitOff: position is past the end" };
+
+    auto [front, back] = split(std::move(m_root), position);
+    m_root = std::move(front);
+    Rope result{};
+    result.m_root = std::move(back);
+    return result;
+}
+
+std::string Rope::substr(std::size_t position, std::size_t count) const
+{
+    if (position > size())
+        throw std::out_of_range{ "Rope::substr: position is past the end" };
+    count = std::min(count, size() - position);
+
+    std::string out{};
+    out.reserve(count);
+    std::size_t chunkStart{ 0 };
+    forEachChunk([&](std::string_view chunk) {
+        std::size_t chunkEnd{ chunkStart + chunk.size() };
+        if (chunkEnd > position)
+        {
+            std::size_t from{ position > chunkStart ? position - chunkStart : 0 };
+            out.append(chunk.substr(from, count - out.size()));
+        }
+        chunkStart = chunkEnd;
+        return out.size() < count;
+    });
+    return out;
+}
+
+std::size_t Rope::find(std::string_view needle, std::size_t from) const
+{
+    if (from > size())
+        return npos;
+    if (needle.empty())
+        return from;
+
+    std::size_t found{ npos };
+    std::size_t chunkStart{ 0 };
+    std::string carry{}; // the last needle.size() - 1 characters before this chunk
+
+    forEachChunk([&](std::string_view chunk) {
+        std::size_t chunkEnd{ chunkStart + chunk.size() };
+
+        // Matches that start in the carried characters and end in this chunk
+        if (!carry.empty() && chunkEnd > from)
+        {
+            std::string seam{ carry };
+            seam.append(chunk.substr(0, needle.size() - 1));
+            std::size_t carryStart{ chunkStart - carry.size() };
+            std::size_t skip{ from > carryStart ? from - carryStart : 0 };
+            std::size_t match{ seam.find(needle, skip) };
+            if (match != std::string::npos && match < carry.size())
+            {
+                found = carryStart + match;
+                return false;
+            }
+        }
+
+        // Matches entirely inside this chunk
+        if (chunkEnd > from)
+        {
+            std::size_t skip{ from > chunkStart ? from - chunkStart : 0 };
+            std::size_t match{ chunk.find(needle, skip) };
+            if (match != std::string_view::npos)
+            {
+                found = chunkStart + match;
+                return false;
+            }
+        }
+
+        carry.append(chunk);
+        if (carry.size() >= needle.size())
+            carry.erase(0, carry.size() - (needle.size() - 1));
+        chunkStart = chunkEnd;
+        return true;
+    });
+    return found;
+}
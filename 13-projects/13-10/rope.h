@@ -0,0 +1,122 @@
+// Header file that defines the Rope class
+//
+// A rope stores a long text as a balanced tree of chunks (up to maxChunk characters
+// each) instead of one contiguous string, so inserting or erasing in the middle of a
+// multi-megabyte document doesn't move everything after it: insert(), erase() and
+// append() split and join the tree in O(log n) expected time.
+//
+// The tree is a treap: nodes are in text order, and each node also has a random
+// priority that is never lower than its children's, which keeps the tree balanced
+// on average no matter what order the edits come in.
+//
+// Reading goes chunk by chunk: forEachChunk() hands out contiguous string_views,
+// which is what fast search routines (memchr and friends, SIMD loops) want.
+
+#ifndef ROPE_H
+#define ROPE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory> // for std::unique_ptr
+#include <string>
+#include <string_view>
+#include <utility> // for std::pair
+
+class Rope
+{
+public:
+    static constexpr std::size_t maxChunk{ 1024 };
+    static constexpr std::size_t npos{ static_cast<std::size_t>(-1) };
+
+private:
+    struct Node;
+    using NodePtr = std::unique_ptr<Node>;
+
+    struct Node
+    {
+        std::string text;
+        std::size_t length; // characters in this whole subtree
+        std::uint32_t priority;
+        NodePtr left;
+        NodePtr right;
+
+        Node(std::string_view chunk, std::uint32_t priority);
+    };
+
+    NodePtr m_root{};
+
+    static std::size_t lengthOf(const NodePtr& node) { return node ? node->length : 0; }
+    static void update(Node& node);
+
+    // Builds a tree from text in O(n), cutting it into chunks of maxChunk
+    static NodePtr build(std::string_view text);
+    static NodePtr clone(const Node* node);
+
+    // Splits a tree into the first position characters and the rest
+    static std::pair<NodePtr, NodePtr> split(NodePtr node, std::size_t position);
+    // Joins two trees, all of a's text before all of b's
+    static NodePtr merge(NodePtr a, NodePtr b);
+
+    // Adds text into the chunk that holds position, if it fits there; false if it doesn't
+    static bool insertInPlace(Node* node, std::size_t position, std::string_view text);
+
+    template <typename Function>
+    static bool visitChunks(const Node* node, Function& function);
+
+public:
+    Rope() = default;
+    Rope(std::string_view text);
+
+    Rope(const Rope& other);
+    Rope& operator=(const Rope& other);
+    Rope(Rope&&) noexcept = default;
+    Rope& operator=(Rope&&) noexcept = default;
+
+    std::size_t size() const { return lengthOf(m_root); }
+    bool empty() const { return !m_root; }
+
+    // The character at position, found by walking down the tree
+    char at(std::size_t position) const;
+
+    // Inserts text before position (position == size() appends)
+    void insert(std::size_t position, std::string_view text);
+
+    // Erases up to count characters starting at position
+    void erase(std::size_t position, std::size_t count);
+
+    // Moves other's text onto the end of this one, leaving other empty
+    void append(Rope&& other);
+    void append(std::string_view text) { insert(size(), text); }
+
+    // Cuts the rope at position: this keeps the front, the back is returned
+    Rope splitOff(std::size_t position);
+
+    // Copies up to count characters starting at position
+    std::string substr(std::size_t position, std::size_t count) const;
+    std::string toString() const { return substr(0, size()); }
+
+    // Position of the first occurrence of needle at or after from, or npos.
+    // Each chunk is searched with std::string_view::find, and matches that straddle
+    // two chunks are caught by also searching the few characters around each seam.
+    std::size_t find(std::string_view needle, std::size_t from = 0) const;
+
+    // Calls function(chunk) with each chunk in order, as a std::string_view, until it
+    // returns false. Returns false if it was stopped early.
+    template <typename Function>
+    bool forEachChunk(Function function) const
+    {
+        return visitChunks(m_root.get(), function);
+    }
+};
+
+template <typename Function>
+bool Rope::visitChunks(const Node* node, Function& function)
+{
+    if (!node)
+        return true;
+    return visitChunks(node->left.get(), function)
+        && function(std::string_view{ node->text })
+        && visitChunks(node->right.get(), function);
+}
+
+#endif
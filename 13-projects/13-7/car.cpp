@@ -0,0 +1,32 @@
+// Member functions of the Car class defined here
+
+#include "car.h"
+#include "../../9-projects/quiz-2/keysort.h"
+
+NameTable& Car::makes()
+{
+    static NameTable table{};
+    return table;
+}
+
+NameTable& Car::models()
+{
+    static NameTable table{};
+    return table;
+}
+
+Car::Car(std::string_view make, std::string_view model)
+    : m_make{ makes().intern(make) }, m_model{ models().intern(model) }
+{
+}
+
+std::ostream& operator<<(std::ostream& out, const Car& car)
+{
+    out << car.make() << ' ' << car.model();
+    return out;
+}
+
+void sortCars(std::vector<Car>& cars)
+{
+    sortByKey(cars, [](const Car& car) { return car.sortKey(); });
+}
@@ -0,0 +1,58 @@
+// Header file that defines the Car class
+//
+// A car holds two interned ids (see NameTable) instead of two strings. That makes
+// it 8 bytes, makes == a compare of two integers, and makes <=> a compare of one
+// integer: sortKey() packs the alphabetical ranks of make and model so that
+// comparing keys is the same as comparing (make, model) as strings.
+//
+// Needs C++20 for operator<=>.
+
+#ifndef CAR_H
+#define CAR_H
+
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <vector>
+#include "nametable.h"
+
+class Car
+{
+private:
+    NameId m_make{};
+    NameId m_model{};
+
+public:
+    // Every make and model seen so far, shared by all cars
+    static NameTable& makes();
+    static NameTable& models();
+
+    Car(std::string_view make, std::string_view model);
+
+    std::string_view make() const { return makes().name(m_make); }
+    std::string_view model() const { return models().name(m_model); }
+
+    // Orders cars by make, then model, like the strings. Only comparable with keys
+    // taken while no new make or model was added.
+    std::uint64_t sortKey() const
+    {
+        return std::uint64_t{ makes().rank(m_make) } * models().size() + models().rank(m_model);
+    }
+
+    // Same ids means same strings, so the defaulted == is right
+    friend bool operator==(const Car& c1, const Car& c2) = default;
+
+    friend std::strong_ordering operator<=>(const Car& c1, const Car& c2)
+    {
+        return c1.sortKey() <=> c2.sortKey();
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const Car& car);
+};
+
+// Sorts cars into the order of <=>, with a linear-time radix sort on sortKey()
+// (cars that compare equal keep their order)
+void sortCars(std::vector<Car>& cars);
+
+#endif
@@ -0,0 +1,101 @@
+// Member and friend functions of the Cents class defined here
+
+#include "cents.h"
+
+#include <stdexcept> // for std::overflow_error
+
+Cents Cents::operator-() const
+{
+    std::int64_t result{};
+    if (__builtin_sub_overflow(std::int64_t{ 0 }, m_cents, &result))
+        throw std::overflow_error{ "Cents overflow" };
+    return result;
+}
+
+Cents& Cents::operator+=(const Cents& other)
+{
+    // Into a local first, so an overflow leaves this unchanged
+    std::int64_t result{};
+    if (__builtin_add_overflow(m_cents, other.m_cents, &result))
+        throw std::overflow_error{ "Cents overflow" };
+    m_cents = result;
+    return *this;
+}
+
+Cents& Cents::operator-=(const Cents& other)
+{
+    // Into a local first, so an overflow leaves this unchanged
+    std::int64_t result{};
+    if (__builtin_sub_overflow(m_cents, other.m_cents, &result))
+        throw std::overflow_error{ "Cents overflow" };
+    m_cents = result;
+    return *this;
+}
+
+Cents operator+ (const Cents& c1, const Cents& c2)
+{
+    Cents result{ c1 };
+    return result += c2;
+}
+
+Cents operator- (const Cents& c1, const Cents& c2)
+{
+    Cents result{ c1 };
+    return result -= c2;
+}
+
+Cents operator* (const Cents& c, std::int64_t quantity)
+{
+    std::int64_t result{};
+    if (__builtin_mul_overflow(c.m_cents, quantity, &result))
+        throw std::overflow_error{ "Cents overflow" };
+    return result;
+}
+
+Cents operator* (std::int64_t quantity, const Cents& c)
+{
+    return c * quantity;
+}
+
+bool operator== (const Cents& c1, const Cents& c2)
+{
+    return c1.m_cents == c2.m_cents;
+}
+
+bool operator!= (const Cents& c1, const Cents& c2)
+{
+    return !(c1 == c2);
+}
+
+bool operator> (const Cents& c1, const Cents& c2)
+{
+    return c1.m_cents > c2.m_cents;
+}
+
+bool operator>= (const Cents& c1, const Cents& c2)
+{
+    return c1.m_cents >= c2.m_cents;
+}
+
+bool operator< (const Cents& c1, const Cents& c2)
+{
+    return !(c1 >= c2);
+}
+
+bool operator<= (const Cents& c1, const Cents& c2)
+{
+    return !(c1 > c2);
+}
+
+std::ostream& operator<< (std::ostream& out, const Cents& c)
+{
+    // Work with the magnitude as unsigned so the most negative value prints correctly
+    bool negative{ c.m_cents < 0 };
+    std::uint64_t magnitude{ negative ? 0 - static_cast<std::uint64_t>(c.m_cents) : static_cast<std::uint64_t>(c.m_cents) };
+    std::uint64_t fraction{ magnitude % 100 };
+
+    if (negative)
+        out << '-';
+    out << magnitude / 100 << '.' << static_cast<char>('0' + fraction / 10) << static_cast<char>('0' + fraction % 10);
+    return out;
+}
@@ -0,0 +1,46 @@
+// Header file that defines the Cents class
+//
+// An amount of money as a whole number of cents in 64 bits. Arithmetic is checked:
+// any result that doesn't fit throws std::overflow_error instead of wrapping.
+
+#ifndef CENTS_H
+#define CENTS_H
+
+#include <cstdint>
+#include <iostream>
+
+class Cents
+{
+private:
+    std::int64_t m_cents{};
+
+public:
+    constexpr Cents(std::int64_t cents = 0)
+        : m_cents{ cents }
+    {}
+
+    constexpr std::int64_t value() const { return m_cents; }
+
+    Cents operator-() const;
+    Cents& operator+=(const Cents& other);
+    Cents& operator-=(const Cents& other);
+
+    friend Cents operator+ (const Cents& c1, const Cents& c2);
+    friend Cents operator- (const Cents& c1, const Cents& c2);
+    friend Cents operator* (const Cents& c, std::int64_t quantity);
+    friend Cents operator* (std::int64_t quantity, const Cents& c);
+
+    friend bool operator== (const Cents& c1, const Cents& c2);
+    friend bool operator!= (const Cents& c1, const Cents& c2);
+
+    friend bool operator> (const Cents& c1, const Cents& c2);
+    friend bool operator<= (const Cents& c1, const Cents& c2);
+
+    friend bool operator< (const Cents& c1, const Cents& c2);
+    friend bool operator>= (const Cents& c1, const Cents& c2);
+
+    // Prints dollars and cents, e.g. -12.05
+    friend std::ostream& operator<< (std::ostream& out, const Cents& c);
+};
+
+#endif
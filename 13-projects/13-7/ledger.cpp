@@ -0,0 +1,166 @@
+// Member functions of the Ledger class defined here
+
+#include "ledger.h"
+
+#include <algorithm>
+#include <exception> // for std::exception_ptr
+#include <stdexcept> // for std::overflow_error
+
+Ledger::Chunk& Ledger::chunkWithRoom()
+{
+    if (m_chunks.empty() || m_chunks.back().accounts.size() == chunkSize)
+    {
+        // Reserve the whole chunk up front so appends never reallocate it
+        Chunk chunk{};
+        chunk.accounts.reserve(chunkSize);
+        chunk.amounts.reserve(chunkSize);
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    return m_chunks.back();
+}
+
+void Ledger::append(AccountId account, Cents amount)
+{
+    Chunk& chunk{ chunkWithRoom() };
+    chunk.accounts.push_back(account);
+    chunk.amounts.push_back(amount);
+
+    ++m_size;
+    m_accountCount = std::max<std::size_t>(m_accountCount, std::size_t{ account } + 1);
+}
+
+void Ledger::append(const AccountId* accounts, const Cents* amounts, std::size_t count)
+{
+    while (count > 0)
+    {
+        Chunk& chunk{ chunkWithRoom() };
+        std::size_t batch{ std::min(count, chunkSize - chunk.accounts.size()) };
+
+        chunk.accounts.insert(chunk.accounts.end(), accounts, accounts + batch);
+        chunk.amounts.insert(chunk.amounts.end(), amounts, amounts + batch);
+
+        AccountId highest{ *std::max_element(accounts, accounts + batch) };
+        m_accountCount = std::max<std::size_t>(m_accountCount, std::size_t{ highest } + 1);
+
+        m_size += batch;
+        accounts += batch;
+        amounts += batch;
+        count -= batch;
+    }
+}
+
+template <typename Work>
+void Ledger::forEachChunkRange(unsigned threadCount, Work work) const
+{
+    std::size_t chunkCount{ m_chunks.size() };
+    threadCount = static_cast<unsigned>(std::clamp<std::size_t>(threadCount, 1, std::max<std::size_t>(chunkCount, 1)));
+    std::size_t perThread{ (chunkCount + threadCount - 1) / threadCount };
+
+    std::vector<std::thread> threads{};
+    std::vector<std::exception_ptr> errors(threadCount);
+
+    for (unsigned t{ 0 }; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            try
+            {
+                std::size_t first{ std::min(chunkCount, t * perThread) };
+                std::size_t last{ std::min(chunkCount, first + perThread) };
+                work(t, first, last);
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+Cents Ledger::total(unsigned threadCount) const
+{
+    // 128-bit partial sums can't overflow, so only the final result is range checked
+    std::vector<__int128> partial(std::max(threadCount, 1u));
+
+    forEachChunkRange(threadCount, [this, &partial](unsigned t, std::size_t first, std::size_t last) {
+        __int128 sum{ 0 };
+        for (std::size_t c{ first }; c < last; ++c)
+        {
+            for (const Cents& amount : m_chunks[c].amounts)
+                sum += amount.value();
+        }
+        partial[t] = sum;
+    });
+
+    __int128 sum{ 0 };
+    for (__int128 part : partial)
+        sum += part;
+
+    if (sum > INT64_MAX || sum < INT64_MIN)
+        throw std::overflow_error{ "Ledger total overflow" };
+
+    return static_cast<std::int64_t>(sum);
+}
+
+std::vector<Cents> Ledger::sumByAccount(unsigned threadCount) const
+{
+    // One dense array of balances per thread, merged at the end. Like total(), a balance
+    // is only range checked once at the end, so it may go out of range and back on the
+    // way. Each thread's balances are 128-bit, split in two: the low 64 bits wrap in
+    // the int64 array the inner loop works on, and the rare wrap is counted in carries,
+    // which is only allocated once one happens.
+    struct Partial
+    {
+        std::vector<std::int64_t> balances;
+        std::vector<std::int64_t> carries;
+    };
+    std::vector<Partial> partial(std::max(threadCount, 1u));
+
+    forEachChunkRange(threadCount, [this, &partial](unsigned t, std::size_t first, std::size_t last) {
+        Partial& part{ partial[t] };
+        part.balances.resize(m_accountCount);
+        for (std::size_t c{ first }; c < last; ++c)
+        {
+            const Chunk& chunk{ m_chunks[c] };
+            for (std::size_t i{ 0 }; i < chunk.accounts.size(); ++i)
+            {
+                AccountId account{ chunk.accounts[i] };
+                std::int64_t amount{ chunk.amounts[i].value() };
+                if (__builtin_add_overflow(part.balances[account], amount, &part.balances[account]))
+                {
+                    if (part.carries.empty())
+                        part.carries.resize(m_accountCount);
+                    part.carries[account] += amount > 0 ? 1 : -1;
+                }
+            }
+        }
+    });
+
+    std::vector<__int128> sums(m_accountCount);
+    for (const Partial& part : partial)
+    {
+        for (std::size_t account{ 0 }; account < part.balances.size(); ++account)
+            sums[account] += part.balances[account];
+        for (std::size_t account{ 0 }; account < part.carries.size(); ++account)
+            sums[account] += static_cast<__int128>(part.carries[account]) << 64;
+    }
+
+    std::vector<Cents> balances(m_accountCount);
+    for (std::size_t account{ 0 }; account < sums.size(); ++account)
+    {
+        if (sums[account] > INT64_MAX || sums[account] < INT64_MIN)
+            throw std::overflow_error{ "Ledger balance overflow" };
+        balances[account] = static_cast<std::int64_t>(sums[account]);
+    }
+
+    return balances;
+}
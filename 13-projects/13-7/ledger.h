@@ -0,0 +1,62 @@
+// Header file that defines the Ledger class
+//
+// A column store of postings (account id, amount in Cents). Postings are appended
+// into fixed-size chunks, one array per column, so appending never moves or copies
+// what is already stored, and aggregation scans plain contiguous arrays of integers.
+
+#ifndef LEDGER_H
+#define LEDGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "cents.h"
+
+class Ledger
+{
+public:
+    using AccountId = std::uint32_t;
+
+    // Postings per chunk: 64Ki postings is 768 KiB of column data
+    static constexpr std::size_t chunkSize{ std::size_t{ 1 } << 16 };
+
+    void append(AccountId account, Cents amount);
+
+    // Appends count postings from two parallel arrays
+    void append(const AccountId* accounts, const Cents* amounts, std::size_t count);
+
+    std::size_t size() const { return m_size; }
+
+    // Number of accounts seen: every posting's id is below this
+    std::size_t accountCount() const { return m_accountCount; }
+
+    // Sum of every posting. Throws std::overflow_error if it doesn't fit in Cents.
+    Cents total(unsigned threadCount = std::thread::hardware_concurrency()) const;
+
+    // Balance per account, indexed by account id, computed by splitting the chunks
+    // across threadCount threads. Ids are expected to be dense (0, 1, 2, ...) since
+    // each thread keeps an array of accountCount() partial sums.
+    // Throws std::overflow_error if an account's balance doesn't fit in Cents.
+    std::vector<Cents> sumByAccount(unsigned threadCount = std::thread::hardware_concurrency()) const;
+
+private:
+    struct Chunk
+    {
+        std::vector<AccountId> accounts;
+        std::vector<Cents> amounts;
+    };
+
+    std::vector<Chunk> m_chunks{};
+    std::size_t m_size{};
+    std::size_t m_accountCount{};
+
+    Chunk& chunkWithRoom();
+
+    // Calls work(threadIndex, firstChunk, lastChunk) on threadCount threads, each with
+    // its own contiguous range of chunks, and rethrows the first exception any of them threw
+    template <typename Work>
+    void forEachChunkRange(unsigned threadCount, Work work) const;
+};
+
+#endif
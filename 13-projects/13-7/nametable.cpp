@@ -0,0 +1,28 @@
+// Member functions of the NameTable class defined here
+
+#include "nametable.h"
+
+#include <algorithm> // for std::sort()
+#include <numeric>   // for std::iota()
+
+NameId NameTable::intern(std::string_view name)
+{
+    if (const NameId* existing{ m_ids.find(name) })
+        return *existing;
+
+    NameId id{ static_cast<NameId>(m_names.size()) };
+    m_names.emplace_back(name);
+    m_ids[name] = id;
+    return id;
+}
+
+void NameTable::rerank() const
+{
+    std::vector<NameId> order(m_names.size());
+    std::iota(order.begin(), order.end(), NameId{ 0 });
+    std::sort(order.begin(), order.end(), [this](NameId a, NameId b) { return m_names[a] < m_names[b]; });
+
+    m_ranks.resize(m_names.size());
+    for (std::size_t rank{ 0 }; rank < order.size(); ++rank)
+        m_ranks[order[rank]] = static_cast<std::uint32_t>(rank);
+}
@@ -0,0 +1,56 @@
+// Header file that defines the NameTable class
+//
+// Interns names: each distinct name is stored once and gets a small dense id
+// (0, 1, 2, ... in the order the names arrive). Two ids from one table are equal
+// exactly when their names are.
+//
+// Ids follow arrival order, so comparing them says nothing about the names. For that
+// each id also has a rank: its name's position in alphabetical order. Ranks compare
+// the way the names do, but they shift whenever a new name arrives, so they are
+// worked out again (one sort of the distinct names) the first time one is asked for
+// after a change. The table is not safe to use from several threads at once.
+
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../13-9/stringmap.h"
+
+using NameId = std::uint32_t;
+
+class NameTable
+{
+private:
+    // Indexed by id. A deque never moves its elements when it grows, so a name, and any
+    // string_view of it, stays put while more names are interned.
+    std::deque<std::string> m_names{};
+    StringMap<NameId> m_ids{};
+    mutable std::vector<std::uint32_t> m_ranks{}; // indexed by id; stale if its size differs from m_names
+
+    void rerank() const;
+
+public:
+    // The id of name, adding it first if it's new
+    NameId intern(std::string_view name);
+
+    // Valid for as long as the table is
+    const std::string& name(NameId id) const { return m_names[id]; }
+
+    // Where name(id) falls in alphabetical order, from 0 to size() - 1
+    std::uint32_t rank(NameId id) const
+    {
+        if (m_ranks.size() != m_names.size())
+            rerank();
+        return m_ranks[id];
+    }
+
+    // Number of distinct names; every id and rank is below this
+    std::size_t size() const { return m_names.size(); }
+};
+
+#endif
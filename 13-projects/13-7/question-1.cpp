@@ -1,41 +1,7 @@
 #include <iostream>
- 
-class Cents
-{
-private:
-    int m_cents;
- 
-public:
-    Cents(int cents)
-	: m_cents{ cents }
-	{}
- 
-    friend bool operator> (const Cents& c1, const Cents& c2);
-    friend bool operator<= (const Cents& c1, const Cents& c2);
- 
-    friend bool operator< (const Cents& c1, const Cents& c2);
-    friend bool operator>= (const Cents& c1, const Cents& c2);
-};
- 
-bool operator> (const Cents& c1, const Cents& c2)
-{
-    return c1.m_cents > c2.m_cents;
-}
- 
-bool operator>= (const Cents& c1, const Cents& c2)
-{
-    return c1.m_cents >= c2.m_cents;
-}
- 
-bool operator< (const Cents& c1, const Cents& c2)
-{
-    return !(c1 >= c2);
-}
- 
-bool operator<= (const Cents& c1, const Cents& c2)
-{
-    return !(c1 > c2);
-}
+#include <vector>
+#include "cents.h"
+#include "ledger.h"
  
 int main()
 {
@@ -50,6 +16,18 @@ int main()
         std::cout << "a dime is greater than a nickel.\n";
     if (nickel <= dime)
         std::cout << "a dime is greater than or equal to a nickel.\n";
+
+    std::cout << dime + nickel * 3 << '\n'; // 0.25
+
+    // Post a few thousand payments to three accounts and total them per account
+    Ledger ledger{};
+    for (int i{ 0 }; i < 100'000; ++i)
+        ledger.append(static_cast<Ledger::AccountId>(i % 3), (i % 2 == 0) ? dime : -nickel);
+
+    std::vector<Cents> balances{ ledger.sumByAccount() };
+    for (std::size_t account{ 0 }; account < balances.size(); ++account)
+        std::cout << "account " << account << ": " << balances[account] << '\n';
+    std::cout << "total: " << ledger.total() << '\n';
  
  
     return 0;
@@ -0,0 +1,452 @@
+// Member functions of the GradeSnapshot class defined here
+//
+// The block is laid out as:
+//   Header                       magic, version, counts, hash seed
+//   std::int32_t  pilots[bucketCount]
+//   std::uint32_t nameOffsets[count + 1]   name of slot i is names[nameOffsets[i], nameOffsets[i + 1])
+//   char          grades[count]
+//   char          names[namesBytes]
+//
+// Perfect hash: a name's 64-bit hash picks one of bucketCount buckets (about 4 names
+// each), and the bucket's pilot picks where its names land. Building tries pilot
+// 0, 1, 2, ... for each bucket, largest buckets first, until all its names hit free
+// slots (the "hash and displace" scheme, as in CHD and PTHash). Buckets of one name
+// don't need a search: they store -(slot + 1) to name their slot directly.
+
+#include "gradesnapshot.h"
+
+#include <algorithm>
+#include <cstring> // for std::memcpy(), std::memcmp()
+#include <fstream>
+#include <limits>
+#include <stdexcept> // for std::invalid_argument, std::runtime_error
+#include <utility> // for std::move()
+
+#include <fcntl.h>    // for open()
+#include <sys/mman.h> // for mmap(), munmap()
+#include <sys/stat.h> // for fstat()
+#include <unistd.h>   // for close()
+
+namespace
+{
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder; // catches a file written on a machine with the other byte order
+        std::uint32_t count;
+        std::uint32_t bucketCount;
+        std::uint64_t seed;
+        std::uint64_t namesBytes;
+    };
+
+    constexpr char magic[8]{ 'G', 'R', 'A', 'D', 'E', 'S', 'N', 'P' };
+    constexpr std::uint32_t version{ 1 };
+    constexpr std::uint32_t byteOrder{ 0x01020304 };
+    constexpr std::uint32_t namesPerBucket{ 4 };
+
+    // Bucket searches give up after this many pilots and the build restarts with a new seed
+    constexpr std::int32_t maxPilot{ 1 << 24 };
+
+    // The final mix of MurmurHash3: every input bit affects every output bit
+    std::uint64_t mix(std::uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // Hashes 8 bytes at a time. Unlike std::hash it's the same in every build,
+    // which matters because the hashes are baked into saved files.
+    std::uint64_t hashName(std::string_view name, std::uint64_t seed)
+    {
+        std::uint64_t h{ seed ^ (name.size() * 0x9E3779B97F4A7C15ULL) };
+        std::size_t i{ 0 };
+        for (; i + 8 <= name.size(); i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, name.data() + i, 8);
+            h = mix(h ^ word);
+        }
+        // Only copy a tail that's there: an empty view may have a null data(), and
+        // memcpy from null is undefined even for 0 bytes. Either way an empty tail is 0.
+        std::uint64_t tail{ 0 };
+        if (i < name.size())
+            std::memcpy(&tail, name.data() + i, name.size() - i);
+        return mix(h ^ tail);
+    }
+
+    // Maps a 32-bit value onto [0, range) with a multiply instead of a division
+    std::uint32_t scale32(std::uint64_t value32, std::uint32_t range)
+    {
+        return static_cast<std::uint32_t>((value32 * range) >> 32);
+    }
+
+    std::uint32_t bucketOf(std::uint64_t hash, std::uint32_t bucketCount)
+    {
+        return scale32(hash >> 32, bucketCount);
+    }
+
+    std::uint32_t slotOf(std::uint64_t hash, std::int32_t pilot, std::uint32_t count)
+    {
+        std::uint64_t mixed{ mix(hash + static_cast<std::uint64_t>(pilot) * 0x9E3779B97F4A7C15ULL) };
+        return static_cast<std::uint32_t>((static_cast<unsigned __int128>(mixed) * count) >> 64);
+    }
+
+    std::size_t blockBytes(const Header& header)
+    {
+        return sizeof(Header)
+            + sizeof(std::int32_t) * header.bucketCount
+            + sizeof(std::uint32_t) * (std::size_t{ header.count } + 1)
+            + header.count
+            + header.namesBytes;
+    }
+
+    // Finds a pilot for every bucket, or returns false if some bucket has no pilot
+    // that works (then the caller tries another seed). slots[i] receives entry i's slot.
+    bool placeAll(const std::vector<std::uint64_t>& hashes, std::uint32_t bucketCount,
+        std::vector<std::int32_t>& pilots, std::vector<std::uint32_t>& slots)
+    {
+        std::uint32_t count{ static_cast<std::uint32_t>(hashes.size()) };
+
+        // Group the entries by bucket (a counting sort)
+        std::vector<std::uint32_t> bucketStart(std::size_t{ bucketCount } + 1, 0);
+        for (std::uint64_t hash : hashes)
+            ++bucketStart[bucketOf(hash, bucketCount) + 1];
+        for (std::uint32_t b{ 0 }; b < bucketCount; ++b)
+            bucketStart[b + 1] += bucketStart[b];
+
+        std::vector<std::uint32_t> members(count);
+        {
+            std::vector<std::uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+            for (std::uint32_t i{ 0 }; i < count; ++i)
+                members[fill[bucketOf(hashes[i], bucketCount)]++] = i;
+        }
+
+        // Largest buckets first, while most slots are still free
+        std::vector<std::uint32_t> order(bucketCount);
+        for (std::uint32_t b{ 0 }; b < bucketCount; ++b)
+            order[b] = b;
+        std::stable_sort(order.begin(), order.end(), [&bucketStart](std::uint32_t a, std::uint32_t b) {
+            return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+
+        std::vector<bool> taken(count, false);
+        pilots.assign(bucketCount, 0);
+        slots.assign(count, 0);
+
+        std::vector<std::uint32_t> trial{};
+        std::uint32_t nextFree{ 0 };
+        for (std::uint32_t bucket : order)
+        {
+            std::uint32_t first{ bucketStart[bucket] };
+            std::uint32_t size{ bucketStart[bucket + 1] - first };
+            if (size == 0)
+                break; // the rest are empty too
+
+            if (size == 1)
+            {
+                while (taken[nextFree])
+                    ++nextFree;
+                taken[nextFree] = true;
+                slots[members[first]] = nextFree;
+                pilots[bucket] = -static_cast<std::int32_t>(nextFree) - 1;
+                continue;
+            }
+
+            trial.resize(size);
+            bool placed{ false };
+            for (std::int32_t pilot{ 0 }; !placed && pilot < maxPilot; ++pilot)
+            {
+                placed = true;
+                for (std::uint32_t k{ 0 }; placed && k < size; ++k)
+                {
+                    std::uint32_t slot{ slotOf(hashes[members[first + k]], pilot, count) };
+                    placed = !taken[slot] && std::find(trial.begin(), trial.begin() + k, slot) == trial.begin() + k;
+                    trial[k] = slot;
+                }
+                if (placed)
+                    pilots[bucket] = pilot;
+            }
+            if (!placed)
+                return false;
+
+            for (std::uint32_t k{ 0 }; k < size; ++k)
+            {
+                taken[trial[k]] = true;
+                slots[members[first + k]] = trial[k];
+            }
+        }
+        return true;
+    }
+}
+
+GradeSnapshot::~GradeSnapshot()
+{
+    unmap();
+}
+
+GradeSnapshot::GradeSnapshot(GradeSnapshot&& other) noexcept
+{
+    moveFrom(other);
+}
+
+GradeSnapshot& GradeSnapshot::operator=(GradeSnapshot&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+void GradeSnapshot::moveFrom(GradeSnapshot& other) noexcept
+{
+    // moving the vector keeps its buffer, so the section pointers stay valid
+    m_data = other.m_data;
+    m_bytes = other.m_bytes;
+    m_count = other.m_count;
+    m_bucketCount = other.m_bucketCount;
+    m_seed = other.m_seed;
+    m_pilots = other.m_pilots;
+    m_nameOffsets = other.m_nameOffsets;
+    m_grades = other.m_grades;
+    m_names = other.m_names;
+    m_namesBytes = other.m_namesBytes;
+    m_owned = std::move(other.m_owned);
+    m_mapping = other.m_mapping;
+
+    other.m_mapping = nullptr;
+    other.m_data = nullptr;
+    other.m_bytes = 0;
+    other.m_count = 0;
+}
+
+void GradeSnapshot::unmap() noexcept
+{
+    if (m_mapping)
+        munmap(m_mapping, m_bytes);
+    m_mapping = nullptr;
+}
+
+void GradeSnapshot::attach(const unsigned char* data, std::size_t bytes)
+{
+    Header header;
+    if (bytes < sizeof(Header))
+        throw std::runtime_error{ "grade snapshot is truncated" };
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+        throw std::runtime_error{ "not a grade snapshot" };
+    if (header.version != version || header.byteOrder != byteOrder)
+        throw std::runtime_error{ "grade snapshot has an unsupported version or byte order" };
+    if (header.count != 0 && header.bucketCount == 0)
+        throw std::runtime_error{ "grade snapshot is corrupt" };
+    if (blockBytes(header) != bytes)
+        throw std::runtime_error{ "grade snapshot has the wrong size" };
+
+    m_data = data;
+    m_bytes = bytes;
+    m_count = header.count;
+    m_bucketCount = header.bucketCount;
+    m_seed = header.seed;
+    m_namesBytes = header.namesBytes;
+
+    const unsigned char* p{ data + sizeof(Header) };
+    m_pilots = reinterpret_cast<const std::int32_t*>(p);
+    p += sizeof(std::int32_t) * m_bucketCount;
+    m_nameOffsets = reinterpret_cast<const std::uint32_t*>(p);
+    p += sizeof(std::uint32_t) * (std::size_t{ m_count } + 1);
+    m_grades = reinterpret_cast<const char*>(p);
+    p += m_count;
+    m_names = reinterpret_cast<const char*>(p);
+}
+
+GradeSnapshot GradeSnapshot::build(const std::vector<Entry>& entries)
+{
+    if (entries.size() >= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+        throw std::invalid_argument{ "too many names for a grade snapshot" };
+
+    std::uint32_t count{ static_cast<std::uint32_t>(entries.size()) };
+    std::uint32_t bucketCount{ std::max<std::uint32_t>(1, (count + namesPerBucket - 1) / namesPerBucket) };
+
+    std::uint64_t namesBytes{ 0 };
+    for (const Entry& entry : entries)
+        namesBytes += entry.name.size();
+    if (namesBytes > std::numeric_limits<std::uint32_t>::max())
+        throw std::invalid_argument{ "names are too long in total for a grade snapshot" };
+
+    std::vector<std::uint64_t> hashes(count);
+    std::vector<std::int32_t> pilots{};
+    std::vector<std::uint32_t> slots{};
+    std::uint64_t seed{ 0x243F6A8885A308D3ULL };
+    for (int attempt{ 0 };; ++attempt, seed = mix(seed + 1))
+    {
+        if (attempt == 100)
+            throw std::runtime_error{ "couldn't build a perfect hash for these names" };
+
+        for (std::uint32_t i{ 0 }; i < count; ++i)
+            hashes[i] = hashName(entries[i].name, seed);
+
+        // Two names with the same 64-bit hash can never be told apart by any pilot:
+        // either they are the same name, or this seed is unlucky
+        std::vector<std::uint32_t> byHash(count);
+        for (std::uint32_t i{ 0 }; i < count; ++i)
+            byHash[i] = i;
+        std::sort(byHash.begin(), byHash.end(), [&hashes](std::uint32_t a, std::uint32_t b) { return hashes[a] < hashes[b]; });
+        bool collision{ false };
+        for (std::uint32_t i{ 1 }; i < count && !collision; ++i)
+        {
+            if (hashes[byHash[i]] == hashes[byHash[i - 1]])
+            {
+                if (entries[byHash[i]].name == entries[byHash[i - 1]].name)
+                    throw std::invalid_argument{ "duplicate name in grade snapshot: " + std::string{ entries[byHash[i]].name } };
+                collision = true;
+            }
+        }
+
+        if (!collision && placeAll(hashes, bucketCount, pilots, slots))
+            break;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byteOrder = byteOrder;
+    header.count = count;
+    header.bucketCount = bucketCount;
+    header.seed = seed;
+    header.namesBytes = namesBytes;
+
+    GradeSnapshot snapshot;
+    snapshot.m_owned.assign(blockBytes(header), 0);
+    unsigned char* data{ snapshot.m_owned.data() };
+    std::memcpy(data, &header, sizeof(Header));
+    std::memcpy(data + sizeof(Header), pilots.data(), sizeof(std::int32_t) * bucketCount);
+    snapshot.attach(data, snapshot.m_owned.size());
+
+    // Entry at each slot, then the names and grades in slot order
+    std::vector<std::uint32_t> entryAt(count);
+    for (std::uint32_t i{ 0 }; i < count; ++i)
+        entryAt[slots[i]] = i;
+
+    std::uint32_t* offsets{ const_cast<std::uint32_t*>(snapshot.m_nameOffsets) };
+    char* grades{ const_cast<char*>(snapshot.m_grades) };
+    char* names{ const_cast<char*>(snapshot.m_names) };
+    std::uint32_t offset{ 0 };
+    for (std::uint32_t slot{ 0 }; slot < count; ++slot)
+    {
+        const Entry& entry{ entries[entryAt[slot]] };
+        offsets[slot] = offset;
+        grades[slot] = entry.grade;
+        std::memcpy(names + offset, entry.name.data(), entry.name.size());
+        offset += static_cast<std::uint32_t>(entry.name.size());
+    }
+    offsets[count] = offset;
+
+    return snapshot;
+}
+
+GradeSnapshot GradeSnapshot::open(const std::string& path)
+{
+    int fd{ ::open(path.c_str(), O_RDONLY) };
+    if (fd < 0)
+        throw std::runtime_error{ "can't open grade snapshot " + path };
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        throw std::runtime_error{ "can't read grade snapshot " + path };
+    }
+
+    std::size_t bytes{ static_cast<std::size_t>(info.st_size) };
+    void* mapping{ mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0) };
+    close(fd); // the mapping stays valid without the descriptor
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error{ "can't map grade snapshot " + path };
+
+    GradeSnapshot snapshot;
+    snapshot.m_mapping = mapping;
+    snapshot.m_bytes = bytes;
+    snapshot.attach(static_cast<const unsigned char*>(mapping), bytes); // unmapped by ~GradeSnapshot if this throws
+    return snapshot;
+}
+
+void GradeSnapshot::save(const std::string& path) const
+{
+    std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+    out.write(reinterpret_cast<const char*>(m_data), static_cast<std::streamsize>(m_bytes));
+    if (!out)
+        throw std::runtime_error{ "can't write grade snapshot " + path };
+}
+
+std::uint32_t GradeSnapshot::slotFor(std::uint64_t hash) const
+{
+    std::int32_t pilot{ m_pilots[bucketOf(hash, m_bucketCount)] };
+    return pilot < 0 ? static_cast<std::uint32_t>(-(pilot + 1)) : slotOf(hash, pilot, m_count);
+}
+
+std::optional<char> GradeSnapshot::gradeAt(std::uint32_t slot, std::string_view name) const
+{
+    if (slot >= m_count)
+        return std::nullopt; // only possible in a corrupt file
+
+    // Every name hashes to some slot, so check it really is this one
+    std::uint32_t begin{ m_nameOffsets[slot] };
+    std::uint32_t end{ m_nameOffsets[slot + 1] };
+    if (begin > end || end > m_namesBytes)
+        return std::nullopt;
+    if (std::string_view{ m_names + begin, end - begin } != name)
+        return std::nullopt;
+    return m_grades[slot];
+}
+
+std::optional<char> GradeSnapshot::find(std::string_view name) const
+{
+    if (m_count == 0)
+        return std::nullopt;
+    return gradeAt(slotFor(hashName(name, m_seed)), name);
+}
+
+void GradeSnapshot::find(const std::string_view* names, std::size_t count, std::optional<char>* grades) const
+{
+    if (m_count == 0)
+    {
+        std::fill(grades, grades + count, std::nullopt);
+        return;
+    }
+
+    constexpr std::size_t batchSize{ 16 };
+    std::uint64_t hashes[batchSize];
+    std::uint32_t slots[batchSize];
+
+    for (std::size_t first{ 0 }; first < count; first += batchSize)
+    {
+        std::size_t batch{ std::min(batchSize, count - first) };
+
+        // Each pass starts the memory reads the next pass needs for the whole batch
+        for (std::size_t i{ 0 }; i < batch; ++i)
+        {
+            hashes[i] = hashName(names[first + i], m_seed);
+            __builtin_prefetch(&m_pilots[bucketOf(hashes[i], m_bucketCount)]);
+        }
+        for (std::size_t i{ 0 }; i < batch; ++i)
+        {
+            slots[i] = slotFor(hashes[i]);
+            __builtin_prefetch(&m_nameOffsets[slots[i]]);
+            __builtin_prefetch(&m_grades[slots[i]]);
+        }
+        for (std::size_t i{ 0 }; i < batch; ++i)
+        {
+            if (slots[i] < m_count)
+                __builtin_prefetch(m_names + m_nameOffsets[slots[i]]);
+        }
+        for (std::size_t i{ 0 }; i < batch; ++i)
+            grades[first + i] = gradeAt(slots[i], names[first + i]);
+    }
+}
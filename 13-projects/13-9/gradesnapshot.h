@@ -0,0 +1,88 @@
+// Header file that defines the GradeSnapshot class
+//
+// A read-only copy of a GradeMap, built once (say after the nightly load) and then
+// only queried. The names are arranged by a minimal perfect hash: a hash function
+// built for exactly this set of names that sends each one to its own slot 0..n-1, so
+// a lookup is one hash and one string compare, with no probing. All the names are
+// stored back to back in one buffer and the grades in a byte array, both in slot order.
+//
+// The whole snapshot is one contiguous block of bytes, so save() writes it out as is
+// and open() maps the file straight into memory (POSIX mmap): startup doesn't rebuild
+// anything, and pages are only read from disk when a lookup touches them.
+
+#ifndef GRADESNAPSHOT_H
+#define GRADESNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class GradeSnapshot
+{
+public:
+    struct Entry
+    {
+        std::string_view name;
+        char grade;
+    };
+
+private:
+    // Where the sections of the block start (see gradesnapshot.cpp for the layout)
+    const unsigned char* m_data{};
+    std::size_t m_bytes{};
+    std::uint32_t m_count{};
+    std::uint32_t m_bucketCount{};
+    std::uint64_t m_seed{};
+    const std::int32_t* m_pilots{};
+    const std::uint32_t* m_nameOffsets{};
+    const char* m_grades{};
+    const char* m_names{};
+    std::uint64_t m_namesBytes{};
+
+    std::vector<unsigned char> m_owned{}; // the block, when built in memory
+    void* m_mapping{};                    // the block, when mapped from a file
+
+    // Checks the header and points the section pointers into the block
+    void attach(const unsigned char* data, std::size_t bytes);
+    void unmap() noexcept;
+    void moveFrom(GradeSnapshot& other) noexcept;
+
+    std::uint32_t slotFor(std::uint64_t hash) const;
+    // The grade in slot, if name is the name stored there
+    std::optional<char> gradeAt(std::uint32_t slot, std::string_view name) const;
+
+public:
+    GradeSnapshot() = default;
+    ~GradeSnapshot();
+
+    GradeSnapshot(const GradeSnapshot&) = delete;
+    GradeSnapshot& operator=(const GradeSnapshot&) = delete;
+
+    GradeSnapshot(GradeSnapshot&& other) noexcept;
+    GradeSnapshot& operator=(GradeSnapshot&& other) noexcept;
+
+    // Builds a snapshot of the given names. Throws std::invalid_argument on a duplicate name.
+    static GradeSnapshot build(const std::vector<Entry>& entries);
+
+    // Maps a file written by save(). Throws std::runtime_error if it can't be opened
+    // or isn't a valid snapshot.
+    static GradeSnapshot open(const std::string& path);
+
+    // Throws std::runtime_error if the file can't be written
+    void save(const std::string& path) const;
+
+    std::size_t size() const { return m_count; }
+
+    // Returns nothing if name isn't in the snapshot
+    std::optional<char> find(std::string_view name) const;
+
+    // Looks up count names at once, grades[i] for names[i]. Much faster per name than
+    // single finds on a large snapshot: each lookup is a chain of dependent memory
+    // reads, and working on 16 names at a time lets their cache misses overlap.
+    void find(const std::string_view* names, std::size_t count, std::optional<char>* grades) const;
+};
+
+#endif
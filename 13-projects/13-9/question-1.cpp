@@ -1,35 +1,39 @@
+#include <cstdio> // for std::remove()
 #include <iostream>
-#include <string>
+#include <string_view>
 #include <vector>
-#include <algorithm>
-
-struct StudentGrade
-{
-    std::string m_name{};
-    char m_grade{};
-};
+#include "gradesnapshot.h"
+#include "stringmap.h"
 
 class GradeMap
 {
 private:
-    std::vector<StudentGrade> m_map{};
+    StringMap<char> m_map{};
 public:
     GradeMap(){};
-    char& operator[] (std::string name)
+
+    // Looking up a name no longer copies it; it's only stored the first time it's seen
+    char& operator[] (std::string_view name)
     {
-        char grade;
-        auto found{std::find_if(begin(m_map), end(m_map), [name](const auto& student) {
-                return (student.m_name == name);
-            })};
-        if (found != end(m_map))
-        {
-            return found->m_grade;
-        }
-        else
-        {
-            m_map.push_back( {name});
-            return m_map.back().m_grade;
-        }
+        return m_map[name];
+    }
+
+    // Call before loading a large roster so the table doesn't keep doubling
+    void reserve(std::size_t students) { m_map.reserve(students); }
+
+    std::size_t size() const { return m_map.size(); }
+
+    // Calls function(name, grade) for every student
+    template <typename Function>
+    void forEach(Function function) const { m_map.forEach(function); }
+
+    // A read-only copy for when the grades won't change any more (see gradesnapshot.h)
+    GradeSnapshot snapshot() const
+    {
+        std::vector<GradeSnapshot::Entry> entries{};
+        entries.reserve(m_map.size());
+        m_map.forEach([&entries](std::string_view name, char grade) { entries.push_back({ name, grade }); });
+        return GradeSnapshot::build(entries);
     }
 };
 
@@ -42,6 +46,13 @@ int main()
  
 	std::cout << "Joe has a grade of " << grades["Joe"] << '\n';
 	std::cout << "Frank has a grade of " << grades["Frank"] << '\n';
+
+	// Freeze the grades into a file, then map it back in as a service would at startup
+	grades.snapshot().save("grades.snapshot");
+	GradeSnapshot frozen{ GradeSnapshot::open("grades.snapshot") };
+	std::cout << "Snapshot: Joe has a grade of " << frozen.find("Joe").value_or('?')
+		<< ", Alex has a grade of " << frozen.find("Alex").value_or('?') << '\n';
+	std::remove("grades.snapshot");
  
 	return 0;
-}
\ No newline at end of file
+}
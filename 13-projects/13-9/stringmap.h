@@ -0,0 +1,328 @@
+// Header file that defines the StringMap class template
+//
+// A hash map from std::string keys to Values, laid out like Google's "Swiss table":
+// open addressing (every entry lives in one flat array, no per-entry nodes) plus a
+// separate array of one control byte per slot. A control byte says whether its slot
+// is empty, deleted, or full, and for full slots it holds 7 bits of the key's hash.
+// Lookups check 16 control bytes at once with SSE2, so most slots that can't match
+// are skipped without touching their keys, and a probe nearly always ends in the
+// first group of 16.
+//
+// Lookups take std::string_view, so a string literal or a slice of a larger buffer
+// can be looked up without building a std::string. A key is only copied when it's
+// inserted.
+
+#ifndef STRINGMAP_H
+#define STRINGMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional> // for std::hash
+#include <memory> // for std::allocator
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility> // for std::move(), std::swap()
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+template <typename Value>
+class StringMap
+{
+private:
+    static constexpr std::size_t groupSize{ 16 };
+
+    // A full slot's control byte is the low 7 bits of its hash (0 to 127), so both of
+    // these are negative, and "empty or deleted" is simply "less than -1"
+    static constexpr std::int8_t emptyControl{ -128 };
+    static constexpr std::int8_t deletedControl{ -2 };
+
+    struct Slot
+    {
+        std::string key;
+        Value value;
+    };
+
+    std::vector<std::int8_t> m_control{}; // one byte per slot
+    Slot* m_slots{};                      // constructed only where the control byte is full
+    std::size_t m_capacity{};             // 0, or a power of two that's at least groupSize
+    std::size_t m_size{};
+    std::size_t m_growthLeft{};           // inserts into empty slots before we must grow
+
+    static constexpr std::size_t npos{ static_cast<std::size_t>(-1) };
+
+    struct Hash
+    {
+        std::size_t groupHash; // picks the first group to probe
+        std::int8_t control;   // stored in the control byte
+    };
+
+    static Hash hashOf(std::string_view key)
+    {
+        // Mix the standard hash, since its low bits alone may not be well spread
+        std::uint64_t h{ static_cast<std::uint64_t>(std::hash<std::string_view>{}(key)) * 0x9E3779B97F4A7C15ULL };
+        h ^= h >> 32;
+        return { static_cast<std::size_t>(h >> 7), static_cast<std::int8_t>(h & 0x7F) };
+    }
+
+    // Bit i of the result is set if control byte i of the group equals byte
+    static std::uint32_t matchByte(const std::int8_t* group, std::int8_t byte)
+    {
+#if defined(__SSE2__)
+        __m128i controls{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)) };
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(byte))));
+#else
+        std::uint32_t mask{ 0 };
+        for (std::size_t i{ 0 }; i < groupSize; ++i)
+            mask |= static_cast<std::uint32_t>(group[i] == byte) << i;
+        return mask;
+#endif
+    }
+
+    static std::uint32_t matchEmptyOrDeleted(const std::int8_t* group)
+    {
+#if defined(__SSE2__)
+        __m128i controls{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)) };
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), controls)));
+#else
+        std::uint32_t mask{ 0 };
+        for (std::size_t i{ 0 }; i < groupSize; ++i)
+            mask |= static_cast<std::uint32_t>(group[i] < -1) << i;
+        return mask;
+#endif
+    }
+
+    // Smallest capacity that holds count entries at a load factor of at most 7/8
+    static std::size_t capacityFor(std::size_t count)
+    {
+        std::size_t capacity{ groupSize };
+        while (capacity - capacity / 8 < count)
+            capacity *= 2;
+        return capacity;
+    }
+
+    // Probes group by group (triangular steps, which visit every group once when the
+    // group count is a power of two) until probe(firstSlotOfGroup) returns true
+    template <typename Probe>
+    void forEachGroup(const Hash& hash, Probe probe) const
+    {
+        std::size_t groupMask{ m_capacity / groupSize - 1 };
+        std::size_t group{ hash.groupHash & groupMask };
+        for (std::size_t step{ 1 }; !probe(group * groupSize); ++step)
+            group = (group + step) & groupMask;
+    }
+
+    std::size_t findIndex(std::string_view key, const Hash& hash) const
+    {
+        if (m_size == 0)
+            return npos;
+
+        std::size_t found{ npos };
+        forEachGroup(hash, [&](std::size_t first) {
+            const std::int8_t* group{ &m_control[first] };
+            for (std::uint32_t mask{ matchByte(group, hash.control) }; mask != 0; mask &= mask - 1)
+            {
+                std::size_t index{ first + static_cast<std::size_t>(__builtin_ctz(mask)) };
+                if (m_slots[index].key == key)
+                {
+                    found = index;
+                    return true;
+                }
+            }
+            // an empty slot means the key was never pushed past this group
+            return matchByte(group, emptyControl) != 0;
+        });
+        return found;
+    }
+
+    std::size_t findInsertIndex(const Hash& hash) const
+    {
+        std::size_t index{};
+        forEachGroup(hash, [&](std::size_t first) {
+            std::uint32_t mask{ matchEmptyOrDeleted(&m_control[first]) };
+            if (mask == 0)
+                return false;
+            index = first + static_cast<std::size_t>(__builtin_ctz(mask));
+            return true;
+        });
+        return index;
+    }
+
+    void destroySlots()
+    {
+        for (std::size_t i{ 0 }; i < m_capacity; ++i)
+        {
+            if (m_control[i] >= 0)
+                m_slots[i].~Slot();
+        }
+    }
+
+    void release()
+    {
+        destroySlots();
+        std::allocator<Slot>{}.deallocate(m_slots, m_capacity);
+        m_slots = nullptr;
+        m_control.clear();
+        m_capacity = m_size = m_growthLeft = 0;
+    }
+
+    // Moves every entry into a fresh table of the given capacity (which also drops
+    // the deleted markers)
+    void resize(std::size_t capacity)
+    {
+        StringMap fresh;
+        fresh.m_slots = std::allocator<Slot>{}.allocate(capacity);
+        fresh.m_control.assign(capacity, emptyControl);
+        fresh.m_capacity = capacity;
+        fresh.m_growthLeft = capacity - capacity / 8;
+
+        for (std::size_t i{ 0 }; i < m_capacity; ++i)
+        {
+            if (m_control[i] >= 0)
+            {
+                Hash hash{ hashOf(m_slots[i].key) };
+                std::size_t index{ fresh.findInsertIndex(hash) };
+                new (&fresh.m_slots[index]) Slot{ std::move(m_slots[i]) };
+                fresh.m_control[index] = hash.control;
+                ++fresh.m_size;
+                --fresh.m_growthLeft;
+            }
+        }
+        swap(fresh);
+    }
+
+public:
+    StringMap() = default;
+
+    StringMap(const StringMap& other)
+    {
+        reserve(other.m_size);
+        other.forEach([this](std::string_view key, const Value& value) { (*this)[key] = value; });
+    }
+
+    StringMap(StringMap&& other) noexcept
+    {
+        swap(other);
+    }
+
+    StringMap& operator=(StringMap other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~StringMap()
+    {
+        release();
+    }
+
+    void swap(StringMap& other) noexcept
+    {
+        std::swap(m_control, other.m_control);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+    }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    std::size_t capacity() const { return m_capacity; }
+
+    // Makes room for count entries, so inserting up to that many never rehashes.
+    // Worth calling before a bulk load: it avoids the pauses while the table doubles.
+    void reserve(std::size_t count)
+    {
+        if (count > m_size + m_growthLeft)
+            resize(capacityFor(count));
+    }
+
+    // Rebuilds the table with room for at least count entries (and no fewer than size())
+    void rehash(std::size_t count)
+    {
+        resize(capacityFor(count > m_size ? count : m_size));
+    }
+
+    // Returns nullptr if key isn't there
+    Value* find(std::string_view key)
+    {
+        std::size_t index{ findIndex(key, hashOf(key)) };
+        return index == npos ? nullptr : &m_slots[index].value;
+    }
+
+    const Value* find(std::string_view key) const
+    {
+        std::size_t index{ findIndex(key, hashOf(key)) };
+        return index == npos ? nullptr : &m_slots[index].value;
+    }
+
+    bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    // Inserts a value-initialized Value if key isn't there yet.
+    // The reference is good until the next insert that grows the table.
+    Value& operator[](std::string_view key)
+    {
+        Hash hash{ hashOf(key) };
+        std::size_t index{ findIndex(key, hash) };
+        if (index != npos)
+            return m_slots[index].value;
+
+        if (m_growthLeft == 0)
+            resize(capacityFor(m_size + 1)); // may just clear out deleted markers
+
+        index = findInsertIndex(hash);
+        new (&m_slots[index]) Slot{ std::string{ key }, Value{} };
+        if (m_control[index] == emptyControl)
+            --m_growthLeft;
+        m_control[index] = hash.control;
+        ++m_size;
+        return m_slots[index].value;
+    }
+
+    // Returns whether key was there
+    bool erase(std::string_view key)
+    {
+        std::size_t index{ findIndex(key, hashOf(key)) };
+        if (index == npos)
+            return false;
+
+        m_slots[index].~Slot();
+        --m_size;
+
+        // If the group still has an empty slot, no probe ever continued past it, so
+        // this slot can go back to empty; otherwise lookups must be told to keep going
+        std::size_t first{ index & ~(groupSize - 1) };
+        if (matchByte(&m_control[first], emptyControl) != 0)
+        {
+            m_control[index] = emptyControl;
+            ++m_growthLeft;
+        }
+        else
+            m_control[index] = deletedControl;
+        return true;
+    }
+
+    void clear()
+    {
+        destroySlots();
+        m_control.assign(m_capacity, emptyControl);
+        m_size = 0;
+        m_growthLeft = m_capacity - m_capacity / 8;
+    }
+
+    // Calls function(key, value) for every entry, in no particular order
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        for (std::size_t i{ 0 }; i < m_capacity; ++i)
+        {
+            if (m_control[i] >= 0)
+                function(std::string_view{ m_slots[i].key }, m_slots[i].value);
+        }
+    }
+};
+
+#endif
@@ -1,23 +1,11 @@
 #include <iostream>
+#include <numeric>
+#include <vector>
+#include "runningstats.h"
 
-class Average
-{
-private:
-    std::int_least32_t m_sum{};
-    std::int_least8_t m_count{};
-public:
-    friend std::ostream& operator<<(std::ostream& out, const Average& average)
-	{
-		out << static_cast<double>(average.m_sum) / average.m_count;
-		return out;
-	}
-    Average& operator+=(int new_int)
-	{
-		m_sum += new_int;
-		++m_count;
-		return *this;
-	}
-};
+// Average used to keep an int_least8_t count, which overflowed after 127 samples.
+// RunningStats still prints the mean, and also tracks variance, min/max and quantiles.
+using Average = RunningStats;
 
 int main()
 {
@@ -40,6 +28,21 @@ int main()
  
 	Average copy{ avg };
 	std::cout << copy << '\n';
+
+	std::cout << "variance: " << avg.variance() << " min: " << avg.min() << " max: " << avg.max()
+		<< " median: " << avg.quantile(0.5) << '\n';
+
+	// Partial results from several threads merge to exactly the serial answer
+	std::vector<int> samples(1'000'000);
+	std::iota(samples.begin(), samples.end(), -500'000);
+
+	Average serial{};
+	for (int sample : samples)
+		serial += sample;
+
+	Average parallel{ parallelStats(samples.data(), samples.size(), 4) };
+	std::cout << std::boolalpha << (serial.mean() == parallel.mean() && serial.variance() == parallel.variance()
+		&& serial.quantile(0.99) == parallel.quantile(0.99)) << '\n';
  
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+// Header file that defines the RunningStats class
+//
+// A streaming accumulator for int samples: count, mean, variance, min/max and
+// approximate quantiles, using a fixed amount of memory no matter how many samples
+// are added. Two accumulators can be merged, so each thread can fill its own and
+// the partial results are combined at the end.
+//
+// Everything is kept in exact integers (the sum, the sum of squares and the quantile
+// histogram are plain counts), so merging is associative and commutative: a parallel
+// reduction gives bit-for-bit the same answer as a serial pass, in any order.
+
+#ifndef RUNNINGSTATS_H
+#define RUNNINGSTATS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept> // for std::domain_error, std::overflow_error
+#include <thread>
+#include <vector>
+
+class RunningStats
+{
+private:
+    using Int128 = __int128; // g++/clang extension
+    using UInt128 = unsigned __int128;
+
+    // Quantile histogram: magnitudes below 16 get a bucket each, larger ones are split
+    // into 16 buckets per power of two, so a bucket is never more than 1/16 wide
+    // relative to its values (about 3% error at the bucket midpoint)
+    static constexpr int subBuckets{ 16 };
+    static constexpr int subBits{ 4 };
+    static constexpr int bucketCount{ subBuckets + (32 - subBits) * subBuckets };
+
+    std::uint64_t m_count{};
+    Int128 m_sum{}; // 64 bits would overflow after 2^32 samples
+    UInt128 m_sumSquares{};
+    int m_min{ std::numeric_limits<int>::max() };
+    int m_max{ std::numeric_limits<int>::min() };
+    std::array<std::uint64_t, bucketCount> m_positive{}; // also holds 0
+    std::array<std::uint64_t, bucketCount> m_negative{};
+
+    static int bucketIndex(std::uint32_t magnitude)
+    {
+        if (magnitude < subBuckets)
+            return static_cast<int>(magnitude);
+
+        int exponent{ 31 - __builtin_clz(magnitude) };
+        int sub{ static_cast<int>((magnitude >> (exponent - subBits)) & (subBuckets - 1)) };
+        return subBuckets + (exponent - subBits) * subBuckets + sub;
+    }
+
+    // Midpoint of the magnitudes that land in bucket index
+    static double bucketMidpoint(int index)
+    {
+        if (index < subBuckets)
+            return index;
+
+        int exponent{ (index - subBuckets) / subBuckets + subBits };
+        int sub{ (index - subBuckets) % subBuckets };
+        double width{ std::ldexp(1.0, exponent - subBits) };
+        double low{ (subBuckets + sub) * width };
+        return low + (width - 1) / 2;
+    }
+
+public:
+    RunningStats& operator+=(int sample)
+    {
+        ++m_count;
+        m_sum += sample;
+        m_sumSquares += static_cast<UInt128>(static_cast<std::int64_t>(sample) * sample);
+        m_min = std::min(m_min, sample);
+        m_max = std::max(m_max, sample);
+
+        if (sample >= 0)
+            ++m_positive[bucketIndex(static_cast<std::uint32_t>(sample))];
+        else
+            ++m_negative[bucketIndex(0u - static_cast<std::uint32_t>(sample))];
+
+        return *this;
+    }
+
+    // Folds another accumulator's samples into this one
+    RunningStats& merge(const RunningStats& other)
+    {
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_sumSquares += other.m_sumSquares;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+
+        for (int i{ 0 }; i < bucketCount; ++i)
+        {
+            m_positive[i] += other.m_positive[i];
+            m_negative[i] += other.m_negative[i];
+        }
+
+        return *this;
+    }
+
+    std::uint64_t count() const { return m_count; }
+    std::int64_t sum() const
+    {
+        if (m_sum < std::numeric_limits<std::int64_t>::min() || m_sum > std::numeric_limits<std::int64_t>::max())
+            throw std::overflow_error{ "RunningStats::sum() doesn't fit in 64 bits" };
+        return static_cast<std::int64_t>(m_sum);
+    }
+
+    double mean() const
+    {
+        if (m_count == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        return static_cast<double>(m_sum) / static_cast<double>(m_count);
+    }
+
+    // Population variance. n * sum(x^2) - sum(x)^2 is computed exactly in 128 bits
+    // (it fits for up to 2^32 samples), so there is no cancellation error.
+    double variance() const
+    {
+        if (m_count == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        UInt128 sumMagnitude{ m_sum < 0 ? 0 - static_cast<UInt128>(m_sum) : static_cast<UInt128>(m_sum) };
+        double n{ static_cast<double>(m_count) };
+
+        if (m_count <= (std::uint64_t{ 1 } << 32))
+        {
+            UInt128 scaled{ m_count * m_sumSquares - sumMagnitude * sumMagnitude };
+            return static_cast<double>(scaled) / (n * n);
+        }
+
+        long double meanValue{ static_cast<long double>(m_sum) / m_count };
+        long double meanSquares{ static_cast<long double>(m_sumSquares) / m_count };
+        return static_cast<double>(std::max(meanSquares - meanValue * meanValue, 0.0L));
+    }
+
+    // Unbiased (n - 1) variance
+    double sampleVariance() const
+    {
+        if (m_count < 2)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        return variance() * static_cast<double>(m_count) / static_cast<double>(m_count - 1);
+    }
+
+    double stddev() const { return std::sqrt(variance()); }
+
+    int min() const
+    {
+        if (m_count == 0)
+            throw std::domain_error{ "RunningStats::min() with no samples" };
+        return m_min;
+    }
+
+    int max() const
+    {
+        if (m_count == 0)
+            throw std::domain_error{ "RunningStats::max() with no samples" };
+        return m_max;
+    }
+
+    // Approximate q-quantile (0 <= q <= 1), e.g. quantile(0.5) for the median.
+    // The answer is the midpoint of the histogram bucket holding that rank, clamped
+    // to [min, max], so it is exact for small values and within ~3% otherwise.
+    double quantile(double q) const
+    {
+        if (m_count == 0)
+            throw std::domain_error{ "RunningStats::quantile() with no samples" };
+
+        q = std::clamp(q, 0.0, 1.0);
+        std::uint64_t rank{ static_cast<std::uint64_t>(q * static_cast<double>(m_count - 1)) };
+        double result{ 0.0 };
+
+        std::uint64_t seen{ 0 };
+        bool found{ false };
+
+        // Most negative first: negative buckets from the largest magnitude down
+        for (int i{ bucketCount - 1 }; i >= 0 && !found; --i)
+        {
+            seen += m_negative[i];
+            if (seen > rank)
+            {
+                result = -bucketMidpoint(i);
+                found = true;
+            }
+        }
+
+        for (int i{ 0 }; i < bucketCount && !found; ++i)
+        {
+            seen += m_positive[i];
+            if (seen > rank)
+            {
+                result = bucketMidpoint(i);
+                found = true;
+            }
+        }
+
+        return std::clamp(result, static_cast<double>(m_min), static_cast<double>(m_max));
+    }
+
+    // Prints the mean, which is what the old Average class printed
+    friend std::ostream& operator<<(std::ostream& out, const RunningStats& stats)
+    {
+        out << stats.mean();
+        return out;
+    }
+};
+
+// Accumulates data[0..count) on threadCount threads, one contiguous slice each,
+// and merges the partial results
+inline RunningStats parallelStats(const int* data, std::size_t count, unsigned threadCount = std::thread::hardware_concurrency())
+{
+    threadCount = std::max(1u, threadCount);
+
+    std::vector<RunningStats> partial(threadCount);
+    std::vector<std::thread> threads{};
+    std::size_t sliceSize{ (count + threadCount - 1) / threadCount };
+
+    for (unsigned t{ 0 }; t < threadCount; ++t)
+    {
+        threads.emplace_back([&partial, data, count, sliceSize, t]() {
+            std::size_t begin{ std::min(count, t * sliceSize) };
+            std::size_t end{ std::min(count, begin + sliceSize) };
+            RunningStats local{};
+            for (std::size_t i{ begin }; i < end; ++i)
+                local += data[i];
+            partial[t] = local;
+        });
+    }
+
+    RunningStats total{};
+    for (unsigned t{ 0 }; t < threadCount; ++t)
+    {
+        threads[t].join();
+        total.merge(partial[t]);
+    }
+
+    return total;
+}
+
+#endif
@@ -0,0 +1,190 @@
+// Header file that defines the CowArray<T> class template
+//
+// A copy-on-write array: copying a CowArray only bumps a reference count, and the
+// copies share one buffer until one of them is written to. The write first gives
+// that copy a buffer of its own ("detaching"), so nobody else sees the change.
+// The count is atomic, so copies can be passed to and dropped on other threads;
+// as with std::shared_ptr, one CowArray object still mustn't be used by two
+// threads at once if either of them writes to it.
+//
+// Because writing through operator[] may move the array to a new buffer, a reference
+// it returned is only good until the array is next copied or written to.
+
+#ifndef COWARRAY_H
+#define COWARRAY_H
+
+#include <atomic>
+#include <cassert> // for assert()
+#include <cstddef>
+#include <initializer_list> // for std::initializer_list
+#include <new>
+#include <utility> // for std::move()
+
+template <typename T>
+class CowArray
+{
+private:
+    // One allocation holds the header and then the elements
+    struct Buffer
+    {
+        std::atomic<int> refs;
+        int length;
+    };
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "CowArray doesn't support over-aligned types");
+    static constexpr std::size_t elementsOffset{ (sizeof(Buffer) + alignof(T) - 1) / alignof(T) * alignof(T) };
+
+    Buffer* m_buffer{}; // nullptr when empty
+
+    static T* elements(Buffer* buffer)
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(buffer) + elementsOffset);
+    }
+
+    // A buffer with room for length elements, none constructed yet
+    static Buffer* allocate(int length)
+    {
+        void* memory{ ::operator new(elementsOffset + sizeof(T) * static_cast<std::size_t>(length)) };
+        return new (memory) Buffer{ { 1 }, length };
+    }
+
+    // Destroys the first constructed elements and frees the buffer
+    static void destroy(Buffer* buffer, int constructed)
+    {
+        T* data{ elements(buffer) };
+        for (int i{ 0 }; i < constructed; ++i)
+            data[i].~T();
+        buffer->~Buffer();
+        ::operator delete(buffer);
+    }
+
+    // Builds a buffer of length elements, element i initialized by init(address, i)
+    template <typename Init>
+    static Buffer* build(int length, Init init)
+    {
+        if (length == 0)
+            return nullptr;
+
+        Buffer* buffer{ allocate(length) };
+        T* data{ elements(buffer) };
+        int constructed{ 0 };
+        try
+        {
+            for (; constructed < length; ++constructed)
+                init(data + constructed, constructed);
+        }
+        catch (...)
+        {
+            destroy(buffer, constructed);
+            throw;
+        }
+        return buffer;
+    }
+
+    void release() noexcept
+    {
+        // acq_rel: whichever copy drops the last reference must see every other copy's
+        // reads of the buffer finish before it destroys it
+        if (m_buffer && m_buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            destroy(m_buffer, m_buffer->length);
+        m_buffer = nullptr;
+    }
+
+    // Makes sure nobody else shares our buffer before we write to it
+    void detach()
+    {
+        if (!m_buffer || m_buffer->refs.load(std::memory_order_acquire) == 1)
+            return;
+
+        const T* source{ elements(m_buffer) };
+        Buffer* copy{ build(m_buffer->length, [source](T* address, int i) { new (address) T(source[i]); }) };
+        release();
+        m_buffer = copy;
+    }
+
+public:
+    CowArray() = default;
+
+    explicit CowArray(int length)
+        : m_buffer{ build(length, [](T* address, int) { new (address) T(); }) }
+    {
+        assert(length >= 0);
+    }
+
+    CowArray(std::initializer_list<T> list)
+        : m_buffer{ build(static_cast<int>(list.size()), [&list](T* address, int i) { new (address) T(list.begin()[i]); }) }
+    {
+    }
+
+    // O(1): shares other's buffer
+    CowArray(const CowArray& other) noexcept
+        : m_buffer{ other.m_buffer }
+    {
+        if (m_buffer)
+            m_buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CowArray(CowArray&& other) noexcept
+        : m_buffer{ other.m_buffer }
+    {
+        other.m_buffer = nullptr;
+    }
+
+    ~CowArray()
+    {
+        release();
+    }
+
+    CowArray& operator=(const CowArray& other) noexcept
+    {
+        // taking the new reference first makes self-assignment harmless
+        Buffer* buffer{ other.m_buffer };
+        if (buffer)
+            buffer->refs.fetch_add(1, std::memory_order_relaxed);
+        release();
+        m_buffer = buffer;
+        return *this;
+    }
+
+    CowArray& operator=(CowArray&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_buffer = other.m_buffer;
+            other.m_buffer = nullptr;
+        }
+        return *this;
+    }
+
+    int getLength() const { return m_buffer ? m_buffer->length : 0; }
+
+    // How many CowArrays share this buffer (0 when empty)
+    int useCount() const { return m_buffer ? m_buffer->refs.load(std::memory_order_relaxed) : 0; }
+
+    // Reading never copies
+    const T& operator[](int index) const
+    {
+        assert(index >= 0 && index < getLength());
+        return elements(m_buffer)[index];
+    }
+
+    // Writing detaches first if the buffer is shared
+    T& operator[](int index)
+    {
+        assert(index >= 0 && index < getLength());
+        detach();
+        return elements(m_buffer)[index];
+    }
+
+    // Writes without handing out a reference
+    void set(int index, T value)
+    {
+        (*this)[index] = std::move(value);
+    }
+
+    const T* begin() const { return m_buffer ? elements(m_buffer) : nullptr; }
+    const T* end() const { return begin() + getLength(); }
+};
+
+#endif
@@ -1,86 +1,17 @@
-#include <iostream>
-#include <cassert>
- 
-class IntArray
-{
-private:
-    int m_len;
-    int* m_array{nullptr};
-
-public:
-    IntArray(int len) : m_len{len} 
-    {
-        assert (len > 0 && "Array length should be a postive integer");
-        m_array = new int[len]{};
-    }
-    ~IntArray()
-    {
-        delete[] m_array;
-    }
-    int& operator[](const int index)
-    {
-        assert (index < m_len && index >= 0 && "Index must be greater than zero and less than length");
-        return m_array[index];
-    }
-    int& operator[](const int index) const
-    {
-        assert (index < m_len && index >= 0 && "Index must be greater than zero and less than length");
-        return m_array[index];
-    }
-    friend std::ostream& operator<<(std::ostream& out, const IntArray& a)
-    {
-        out << a[0] << ' ' << a[1] << ' ' << a[2] << ' ' << a[3] << ' ' << a[4];
-        return out;
-    }
-
-    // deep copy constructor
-    IntArray(const IntArray& a) : m_len{a.m_len}
-    {
-        delete[] m_array;
+#include "cowarray.h"
 
-        if (a.m_array)
-        {
-            m_array = new int[m_len];
-            for (int i{}; i < m_len; ++i)
-            {
-                m_array[i] = a[i];
-            }
-        }
-        else
-        {
-            m_array = nullptr;
-        }
-    }
+#include <iostream>
 
-    // assigment operator that does a deep copy
-    IntArray& operator=(const IntArray& a)
-    {
-        // do a self-assignment check; if not self-assigning then proceed to do a deep copy
-        if (this == &a)
-        {
-            return *this;
-        }
+// CowArray<int> copies in O(1) by sharing its buffer until a copy is written to.
+// Array<int> from 16-projects/16-7, which always copies deeply, works here too.
+using IntArray = CowArray<int>;
 
-        // delete any memory currently in m_array
-        delete[] m_array;
-        // copy array length
-        m_len = a.m_len;
-        // do the assignment
-        if (a.m_array)
-        {
-            m_array = new int[a.m_len];
-            for (int j{}; j < a.m_len; ++j)
-            {
-                m_array[j] = a[j];
-            }
-        }
-        else
-        {
-            m_array = nullptr;
-        }
-        return *this;
-    }
-};
+std::ostream& operator<<(std::ostream& out, const IntArray& a)
+{
+    for (int i{ 0 }; i < a.getLength(); ++i)
+        out << (i == 0 ? "" : " ") << a[i];
+    return out;
+}
 
 IntArray fillArray()
 {
@@ -107,6 +38,11 @@ int main()
 	b = a;
  
 	std::cout << b << '\n';
+	std::cout << "sharing: " << a.useCount() << '\n';
+
+	// writing to b gives it its own buffer, so a is left alone
+	b[0] = 1;
+	std::cout << a << " / " << b << ", sharing: " << a.useCount() << '\n';
  
 	return 0;
 }
\ No newline at end of file
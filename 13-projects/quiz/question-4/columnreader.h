@@ -0,0 +1,141 @@
+// Header file that defines the ColumnReader<FP> class template
+//
+// Streams a column of decimal values (one per line by default, or separated by
+// another delimiter) out of an std::istream. Input is read in large blocks and each
+// field is parsed in place with fromChars(), so there is no per-value std::string,
+// locale lookup or double conversion.
+
+#ifndef COLUMNREADER_H
+#define COLUMNREADER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>      // for std::memchr(), std::memmove()
+#include <iostream>
+#include <stdexcept>    // for std::runtime_error
+#include <string>
+#include <system_error> // for std::errc
+#include <vector>
+
+template <typename FP>
+class ColumnReader
+{
+private:
+    std::istream& m_in;
+    std::vector<char> m_buffer;
+    std::size_t m_begin{};  // first unconsumed byte in m_buffer
+    std::size_t m_end{};    // one past the last valid byte in m_buffer
+    char m_delimiter{};
+    std::size_t m_field{};  // number of fields returned so far, for error messages
+    bool m_eof{};
+
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    const char* findSeparator(const char* first, const char* last) const
+    {
+        // memchr is vectorized by the C library, so the common one-per-line case stays fast
+        if (m_delimiter == '\n')
+        {
+            const void* found{ std::memchr(first, '\n', static_cast<std::size_t>(last - first)) };
+            return found ? static_cast<const char*>(found) : last;
+        }
+
+        return std::find_if(first, last, [this](char c) { return c == m_delimiter || c == '\n'; });
+    }
+
+    // Moves the unconsumed tail to the front and appends more input.
+    // Returns false once nothing more can be read.
+    bool refill()
+    {
+        if (m_eof)
+            return false;
+
+        std::size_t remaining{ m_end - m_begin };
+        if (m_begin > 0)
+        {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, remaining);
+            m_begin = 0;
+            m_end = remaining;
+        }
+
+        // A single field longer than the whole buffer: make room for it
+        if (m_end == m_buffer.size())
+            m_buffer.resize(m_buffer.size() * 2);
+
+        m_in.read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+        std::size_t count{ static_cast<std::size_t>(m_in.gcount()) };
+        m_end += count;
+
+        if (!m_in)
+            m_eof = true;
+
+        return count > 0;
+    }
+
+public:
+    explicit ColumnReader(std::istream& in, char delimiter = '\n', std::size_t bufferSize = 1 << 16)
+        : m_in{ in }, m_buffer(std::max<std::size_t>(bufferSize, 64)), m_delimiter{ delimiter }
+    {
+    }
+
+    // Reads the next value. Returns false at the end of the input.
+    // Blank fields are skipped; a field that isn't a valid number throws std::runtime_error.
+    bool next(FP& value)
+    {
+        while (true)
+        {
+            const char* data{ m_buffer.data() };
+            const char* first{ data + m_begin };
+            const char* last{ data + m_end };
+
+            while (first != last && (isSpace(*first) || *first == m_delimiter))
+                ++first;
+            m_begin = static_cast<std::size_t>(first - data);
+
+            const char* separator{ findSeparator(first, last) };
+            if (separator == last && !m_eof)
+            {
+                // The field may continue past the end of the buffer
+                if (!refill() && m_begin == m_end)
+                    return false;
+                continue;
+            }
+
+            if (first == last)
+                return false;
+
+            const char* fieldEnd{ separator };
+            while (fieldEnd != first && isSpace(*(fieldEnd - 1)))
+                --fieldEnd;
+
+            auto [end, ec]{ fromChars(first, fieldEnd, value) };
+            if (ec != std::errc{} || end != fieldEnd)
+            {
+                throw std::runtime_error{ "ColumnReader: bad value '" + std::string(first, fieldEnd)
+                                          + "' in field " + std::to_string(m_field + 1) };
+            }
+
+            m_begin = static_cast<std::size_t>(separator - data) + (separator != last);
+            ++m_field;
+            return true;
+        }
+    }
+
+    // Appends every remaining value to out and returns how many were read
+    std::size_t readAll(std::vector<FP>& out)
+    {
+        std::size_t count{ 0 };
+        FP value{};
+        while (next(value))
+        {
+            out.push_back(value);
+            ++count;
+        }
+        return count;
+    }
+};
+
+#endif
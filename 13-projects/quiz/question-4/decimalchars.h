@@ -0,0 +1,244 @@
+// Header file with from_chars/to_chars style routines that convert directly
+// between ASCII decimal text and a scaled integer (the representation FixedPoint uses).
+//
+// "5.01" with two decimals parses to exactly 501: no double is involved, so there is
+// no binary rounding. Digit runs are scanned and converted eight bytes at a time
+// (SWAR: SIMD within a register) which works on any 64-bit target without intrinsics.
+
+#ifndef DECIMALCHARS_H
+#define DECIMALCHARS_H
+
+#include <charconv>     // for std::from_chars_result, std::to_chars_result
+#include <cstddef>
+#include <cstdint>
+#include <cstring>      // for std::memcpy()
+#include <limits>
+#include <system_error> // for std::errc
+#include <type_traits>
+
+namespace decimal
+{
+    // Longest text formatScaled() can produce for Int: sign, digits and a decimal point
+    template <typename Int>
+    constexpr int maxChars{ std::numeric_limits<Int>::digits10 + 3 };
+
+    namespace detail
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        constexpr bool useSwar{ true };
+#else
+        constexpr bool useSwar{ false };
+#endif
+
+        inline std::uint64_t load8(const char* p)
+        {
+            std::uint64_t word{};
+            std::memcpy(&word, p, sizeof(word));
+            return word;
+        }
+
+        // High bit set in every byte of word that is NOT an ASCII digit
+        inline std::uint64_t nonDigitMask(std::uint64_t word)
+        {
+            std::uint64_t x{ word ^ 0x3030303030303030ULL }; // '0'..'9' become 0..9
+            // For a 7-bit byte, adding 0x76 sets the high bit exactly when it is >= 10,
+            // and never carries into the next byte. OR with x catches bytes >= 0x80.
+            return (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL) | x) & 0x8080808080808080ULL;
+        }
+
+        // Converts eight ASCII digits to their value with three multiplies instead of eight
+        inline std::uint32_t parseEightDigits(std::uint64_t word)
+        {
+            word -= 0x3030303030303030ULL;
+            word = (word * 10) + (word >> 8);
+            word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+                    + (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+            return static_cast<std::uint32_t>(word);
+        }
+
+        // Two-digit lookup table used when formatting ("00", "01", ..., "99")
+        struct DigitPairs
+        {
+            char chars[200]{};
+
+            constexpr DigitPairs()
+            {
+                for (int i{ 0 }; i < 100; ++i)
+                {
+                    chars[i * 2] = static_cast<char>('0' + i / 10);
+                    chars[i * 2 + 1] = static_cast<char>('0' + i % 10);
+                }
+            }
+        };
+
+        inline constexpr DigitPairs digitPairs{};
+
+        // Writes exactly count digits of value, right to left, ending at end
+        inline void writeDigits(char* end, std::uint64_t value, int count)
+        {
+            while (count >= 2)
+            {
+                std::memcpy(end - 2, &digitPairs.chars[(value % 100) * 2], 2);
+                value /= 100;
+                end -= 2;
+                count -= 2;
+            }
+            if (count == 1)
+                *(end - 1) = static_cast<char>('0' + value % 10);
+        }
+
+        inline int countDecimalDigits(std::uint64_t value)
+        {
+            int count{ 1 };
+            while (value >= 10)
+            {
+                value /= 10;
+                ++count;
+            }
+            return count;
+        }
+    }
+
+    // Number of consecutive ASCII digits at the start of [first, last)
+    inline std::size_t countDigits(const char* first, const char* last)
+    {
+        const char* p{ first };
+
+        if constexpr (detail::useSwar)
+        {
+            while (last - p >= 8)
+            {
+                std::uint64_t mask{ detail::nonDigitMask(detail::load8(p)) };
+                if (mask != 0)
+                    return static_cast<std::size_t>(p - first) + __builtin_ctzll(mask) / 8;
+                p += 8;
+            }
+        }
+
+        while (p != last && *p >= '0' && *p <= '9')
+            ++p;
+
+        return static_cast<std::size_t>(p - first);
+    }
+
+    // Accumulates count digits starting at p into value, eight at a time where possible.
+    // The caller guarantees the result fits in 64 bits.
+    inline std::uint64_t accumulateDigits(std::uint64_t value, const char* p, std::size_t count)
+    {
+        if constexpr (detail::useSwar)
+        {
+            for (; count >= 8; count -= 8, p += 8)
+                value = value * 100000000ULL + detail::parseEightDigits(detail::load8(p));
+        }
+
+        for (; count > 0; --count, ++p)
+            value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+
+        return value;
+    }
+
+    // Parses an optionally negative decimal such as "-12.345" from [first, last) into
+    // raw = value * 10^decimals. Extra fraction digits are rounded half away from zero.
+    // Like std::from_chars, a leading '+' or whitespace is not accepted, ptr points one
+    // past the last character consumed, and raw is left untouched on error.
+    template <typename Int>
+    std::from_chars_result parseScaled(const char* first, const char* last, int decimals, Int& raw)
+    {
+        static_assert(std::is_integral_v<Int> && std::is_signed_v<Int>, "Int must be a signed integer");
+
+        const char* p{ first };
+        bool negative{ p != last && *p == '-' };
+        if (negative)
+            ++p;
+
+        std::size_t intDigits{ countDigits(p, last) };
+        const char* intBegin{ p };
+        p += intDigits;
+
+        const char* fracBegin{ p };
+        std::size_t fracDigits{ 0 };
+        if (p != last && *p == '.')
+        {
+            fracBegin = p + 1;
+            fracDigits = countDigits(fracBegin, last);
+            p = fracBegin + fracDigits;
+        }
+
+        if (intDigits == 0 && fracDigits == 0)
+            return { first, std::errc::invalid_argument };
+
+        // Leading zeros don't count towards the magnitude
+        while (intDigits > 0 && *intBegin == '0')
+        {
+            ++intBegin;
+            --intDigits;
+        }
+
+        // A uint64 holds any 19-digit number, so anything longer is out of range for
+        // every supported Int before we even look at the digits
+        if (intDigits + static_cast<std::size_t>(decimals) > 19)
+            return { p, std::errc::result_out_of_range };
+
+        std::size_t usedFrac{ fracDigits < static_cast<std::size_t>(decimals) ? fracDigits : static_cast<std::size_t>(decimals) };
+
+        std::uint64_t magnitude{ accumulateDigits(0, intBegin, intDigits) };
+        magnitude = accumulateDigits(magnitude, fracBegin, usedFrac);
+        for (std::size_t i{ usedFrac }; i < static_cast<std::size_t>(decimals); ++i)
+            magnitude *= 10;
+
+        // Half away from zero only needs the first dropped digit
+        if (fracDigits > usedFrac && fracBegin[usedFrac] >= '5')
+            ++magnitude;
+
+        using Unsigned = std::make_unsigned_t<Int>;
+        std::uint64_t limit{ static_cast<Unsigned>(std::numeric_limits<Int>::max()) + std::uint64_t{ negative } };
+        if (magnitude > limit)
+            return { p, std::errc::result_out_of_range };
+
+        raw = negative ? static_cast<Int>(0 - static_cast<Unsigned>(magnitude)) : static_cast<Int>(magnitude);
+        return { p, std::errc{} };
+    }
+
+    // Writes raw / 10^decimals as decimal text with exactly decimals fraction digits.
+    // Nothing is null-terminated. Returns {last, std::errc::value_too_large} if the
+    // buffer is too small, in which case its contents are unspecified.
+    template <typename Int>
+    std::to_chars_result formatScaled(char* first, char* last, Int raw, int decimals)
+    {
+        static_assert(std::is_integral_v<Int> && std::is_signed_v<Int>, "Int must be a signed integer");
+
+        using Unsigned = std::make_unsigned_t<Int>;
+        bool negative{ raw < 0 };
+        std::uint64_t magnitude{ negative ? static_cast<Unsigned>(0 - static_cast<Unsigned>(raw)) : static_cast<Unsigned>(raw) };
+
+        std::uint64_t scale{ 1 };
+        for (int i{ 0 }; i < decimals; ++i)
+            scale *= 10;
+
+        std::uint64_t whole{ magnitude / scale };
+        std::uint64_t fraction{ magnitude % scale };
+
+        int wholeDigits{ detail::countDecimalDigits(whole) };
+        std::ptrdiff_t length{ negative + wholeDigits + (decimals > 0 ? decimals + 1 : 0) };
+        if (last - first < length)
+            return { last, std::errc::value_too_large };
+
+        char* p{ first };
+        if (negative)
+            *p++ = '-';
+
+        detail::writeDigits(p + wholeDigits, whole, wholeDigits);
+        p += wholeDigits;
+
+        if (decimals > 0)
+        {
+            *p++ = '.';
+            detail::writeDigits(p + decimals, fraction, decimals);
+            p += decimals;
+        }
+
+        return { p, std::errc{} };
+    }
+}
+
+#endif
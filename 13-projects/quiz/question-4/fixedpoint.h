@@ -0,0 +1,240 @@
+// Header file that defines the FixedPoint<Decimals, Storage, Mode> class template
+//
+// The value is kept as a single integer scaled by 10^Decimals, so 1.98 with two
+// decimals is stored as 198. All arithmetic stays in integers: there is no
+// floating point on the +, -, *, / paths (double only appears in the explicit
+// conversion constructor and conversion operator at the boundaries).
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <cmath>     // for std::round() in the double constructor
+#include <cstdint>
+#include <iostream>
+#include <iterator>  // for std::begin(), std::end()
+#include <limits>
+#include <stdexcept> // for std::overflow_error, std::domain_error
+#include <string>
+#include <type_traits>
+#include "decimalchars.h"
+
+// What to do when a result doesn't fit in Storage
+enum class Overflow
+{
+    checked,  // throw std::overflow_error
+    saturate, // clamp to the largest/smallest representable value
+};
+
+namespace fixedpoint_detail
+{
+    // Next wider signed integer, used so that a * b and a * scale can't overflow
+    // before we get a chance to round and range-check them
+    template <typename T> struct Wider;
+    template <> struct Wider<std::int8_t>  { using type = std::int16_t; };
+    template <> struct Wider<std::int16_t> { using type = std::int32_t; };
+    template <> struct Wider<std::int32_t> { using type = std::int64_t; };
+#ifdef __SIZEOF_INT128__
+    template <> struct Wider<std::int64_t> { using type = __int128; };
+#endif
+
+    template <typename T>
+    using wider_t = typename Wider<T>::type;
+
+    constexpr std::int64_t pow10(int exponent)
+    {
+        std::int64_t result{ 1 };
+        for (int i{ 0 }; i < exponent; ++i)
+            result *= 10;
+        return result;
+    }
+
+    // Divide, rounding half away from zero (same rule as std::round). Types narrower
+    // than int are promoted by the arithmetic anyway, so it is done in (at least) int
+    // and narrowed once at the end.
+    template <typename W>
+    constexpr W divRound(W numerator, W denominator)
+    {
+        using Calc = std::common_type_t<W, int>;
+        Calc n{ numerator };
+        Calc d{ denominator };
+
+        Calc quotient{ n / d };
+        Calc remainder{ n % d };
+        Calc absRemainder{ remainder < 0 ? -remainder : remainder };
+        Calc absDenominator{ d < 0 ? -d : d };
+
+        if (absRemainder * 2 >= absDenominator)
+            quotient += ((n < 0) != (d < 0)) ? -1 : 1;
+
+        return static_cast<W>(quotient);
+    }
+}
+
+template <int Decimals, typename Storage = std::int64_t, Overflow Mode = Overflow::checked>
+class FixedPoint
+{
+    static_assert(std::is_integral_v<Storage> && std::is_signed_v<Storage>, "Storage must be a signed integer");
+    static_assert(Decimals >= 0 && Decimals < std::numeric_limits<Storage>::digits10, "Decimals doesn't fit in Storage");
+
+private:
+    using Wide = fixedpoint_detail::wider_t<Storage>;
+
+    Storage m_raw{}; // value * scale
+
+    // Narrow a wide intermediate back to Storage according to Mode
+    static constexpr Storage narrow(Wide value)
+    {
+        constexpr Wide max{ std::numeric_limits<Storage>::max() };
+        constexpr Wide min{ std::numeric_limits<Storage>::min() };
+
+        if (value > max || value < min)
+        {
+            if constexpr (Mode == Overflow::saturate)
+                return static_cast<Storage>(value > max ? max : min);
+            else
+                throw std::overflow_error{ "FixedPoint overflow" };
+        }
+
+        return static_cast<Storage>(value);
+    }
+
+public:
+    using storage_type = Storage;
+    using wide_type = Wide;
+
+    static constexpr int decimals{ Decimals };
+    static constexpr Overflow overflow{ Mode };
+    static constexpr Storage scale{ static_cast<Storage>(fixedpoint_detail::pow10(Decimals)) };
+
+    constexpr FixedPoint() = default;
+
+    // FixedPoint<2>{ 34, 56 } is 34.56. If either part is negative the whole value
+    // is negative, so { -2, 8 }, { 2, -8 } and { -2, -8 } are all -2.08
+    constexpr FixedPoint(Storage whole, Storage fraction)
+    {
+        bool negative{ whole < 0 || fraction < 0 };
+        Wide magnitude{ static_cast<Wide>(whole < 0 ? -static_cast<Wide>(whole) : whole) * scale
+                        + (fraction < 0 ? -static_cast<Wide>(fraction) : fraction) };
+        m_raw = narrow(negative ? -magnitude : magnitude);
+    }
+
+    // Converting from double rounds once, here, to the nearest representable value
+    explicit FixedPoint(double value)
+    {
+        double scaled{ std::round(value * static_cast<double>(scale)) };
+        if (!(scaled >= static_cast<double>(std::numeric_limits<Storage>::min())
+              && scaled <= static_cast<double>(std::numeric_limits<Storage>::max())))
+        {
+            if constexpr (Mode == Overflow::saturate)
+            {
+                m_raw = (scaled > 0) ? std::numeric_limits<Storage>::max() : std::numeric_limits<Storage>::min();
+                return;
+            }
+            else
+                throw std::overflow_error{ "FixedPoint overflow" };
+        }
+        m_raw = static_cast<Storage>(scaled);
+    }
+
+    // Build directly from the scaled integer, e.g. fromRaw(198) is 1.98 with two decimals
+    static constexpr FixedPoint fromRaw(Storage raw)
+    {
+        FixedPoint result{};
+        result.m_raw = raw;
+        return result;
+    }
+
+    // Same, from a wider intermediate: out-of-range values throw or saturate according to Mode
+    static constexpr FixedPoint fromWide(Wide raw)
+    {
+        return fromRaw(narrow(raw));
+    }
+
+    constexpr Storage raw() const { return m_raw; }
+    constexpr Storage whole() const { return m_raw / scale; }
+    constexpr Storage fraction() const { return m_raw % scale; }
+
+    explicit operator double() const
+    {
+        return static_cast<double>(m_raw) / static_cast<double>(scale);
+    }
+
+    constexpr FixedPoint operator-() const
+    {
+        return fromRaw(narrow(-static_cast<Wide>(m_raw)));
+    }
+
+    friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b)
+    {
+        return fromRaw(narrow(static_cast<Wide>(a.m_raw) + b.m_raw));
+    }
+
+    friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b)
+    {
+        return fromRaw(narrow(static_cast<Wide>(a.m_raw) - b.m_raw));
+    }
+
+    // (a * scale) * (b * scale) has scale^2, so divide one scale back out and round
+    friend constexpr FixedPoint operator*(FixedPoint a, FixedPoint b)
+    {
+        Wide product{ static_cast<Wide>(a.m_raw) * b.m_raw };
+        return fromRaw(narrow(fixedpoint_detail::divRound<Wide>(product, scale)));
+    }
+
+    // Pre-multiply the dividend by scale so the quotient keeps its scale
+    friend constexpr FixedPoint operator/(FixedPoint a, FixedPoint b)
+    {
+        if (b.m_raw == 0)
+            throw std::domain_error{ "FixedPoint division by zero" };
+
+        Wide dividend{ static_cast<Wide>(a.m_raw) * scale };
+        return fromRaw(narrow(fixedpoint_detail::divRound<Wide>(dividend, b.m_raw)));
+    }
+
+    constexpr FixedPoint& operator+=(FixedPoint other) { return *this = *this + other; }
+    constexpr FixedPoint& operator-=(FixedPoint other) { return *this = *this - other; }
+    constexpr FixedPoint& operator*=(FixedPoint other) { return *this = *this * other; }
+    constexpr FixedPoint& operator/=(FixedPoint other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(FixedPoint a, FixedPoint b) { return a.m_raw == b.m_raw; }
+    friend constexpr bool operator!=(FixedPoint a, FixedPoint b) { return a.m_raw != b.m_raw; }
+    friend constexpr bool operator<(FixedPoint a, FixedPoint b) { return a.m_raw < b.m_raw; }
+    friend constexpr bool operator>(FixedPoint a, FixedPoint b) { return a.m_raw > b.m_raw; }
+    friend constexpr bool operator<=(FixedPoint a, FixedPoint b) { return a.m_raw <= b.m_raw; }
+    friend constexpr bool operator>=(FixedPoint a, FixedPoint b) { return a.m_raw >= b.m_raw; }
+
+    // Parses decimal text such as "-5.01" straight into the scaled integer (see decimalchars.h)
+    friend std::from_chars_result fromChars(const char* first, const char* last, FixedPoint& f)
+    {
+        return decimal::parseScaled(first, last, Decimals, f.m_raw);
+    }
+
+    // Writes the exact decimal value, e.g. "-0.48", without going through double
+    friend std::to_chars_result toChars(char* first, char* last, FixedPoint f)
+    {
+        return decimal::formatScaled(first, last, f.m_raw, Decimals);
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, FixedPoint f)
+    {
+        char buffer[decimal::maxChars<Storage>]{};
+        auto [end, ec]{ toChars(std::begin(buffer), std::end(buffer), f) };
+        out.write(buffer, end - buffer);
+        return out;
+    }
+
+    // Reads one whitespace-delimited token; sets failbit unless the whole token is a number
+    friend std::istream& operator>>(std::istream& in, FixedPoint& f)
+    {
+        std::string token{};
+        if (in >> token)
+        {
+            auto [end, ec]{ fromChars(token.data(), token.data() + token.size(), f) };
+            if (ec != std::errc{} || end != token.data() + token.size())
+                in.setstate(std::ios_base::failbit);
+        }
+        return in;
+    }
+};
+
+#endif
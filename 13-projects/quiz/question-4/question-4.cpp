@@ -1,65 +1,18 @@
 #include <iostream>
-#include <cstdlib>
-#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+#include "fixedpoint.h"
+#include "columnreader.h"
+#include "columnkernels.h"
 
-class FixedPoint2
-{
-private:
-    int m_nonfrac{};
-    int m_numerator{};
-    int m_denom{100};
-public:
-    FixedPoint2(int nonfrac = 0, int numerator = 0) : m_nonfrac{nonfrac}, m_numerator{numerator}
-    {
-        if (m_nonfrac < 0 && m_numerator >= 0)
-        {
-            m_numerator = -m_numerator;
-        }
-        if (m_numerator < 0 && m_nonfrac >= 0)
-        {
-            m_nonfrac = -m_nonfrac;
-        }
-    }
-    FixedPoint2(double input)
-        :   m_nonfrac{static_cast<int>(std::round(input*100)/100)}, 
-            m_numerator{static_cast<int>( std::round(input * 100) - m_nonfrac*100 )  }
-    {}
-    friend std::ostream& operator<<(std::ostream& out, FixedPoint2& f)
-    {
-        out << static_cast<double>(f);
-        return out;
-    }
-
-    operator double() const
-    {
-        return m_nonfrac + static_cast<double>(m_numerator) / 100;
-    }
-
-    friend bool operator==(const FixedPoint2& a, const FixedPoint2& b)
-    {
-        return (a.m_nonfrac == b.m_nonfrac && a.m_numerator == b.m_numerator);
-    }
+// FixedPoint2 used to hold separate whole/fraction ints and add through double.
+// It is now a FixedPoint that keeps one scaled integer and never leaves integer math.
+using FixedPoint2 = FixedPoint<2>;
 
-    friend std::istream& operator>>(std::istream& in, FixedPoint2& f)
-    {
-        double input{};
-        in >> input;
-        f = {input};
-        return in;
-    }
-
-    FixedPoint2 operator-() const
-    {
-        return {-m_nonfrac, -m_numerator};
-    }
-
-    
-};
-
-FixedPoint2 operator+(const FixedPoint2& a, const FixedPoint2& b)
-{
-    return FixedPoint2{static_cast<double>(a) + static_cast<double>(b)};
-}
+static_assert(FixedPoint2{ 0, 75 } + FixedPoint2{ 1, 50 } == FixedPoint2{ 2, 25 });
+static_assert(FixedPoint2{ 1, 50 } * FixedPoint2{ -2, 25 } == FixedPoint2{ -3, 38 }); // -3.375 rounds away from zero
+static_assert(FixedPoint2{ 1, 0 } / FixedPoint2{ 3, 0 } == FixedPoint2{ 0, 33 });
 
 void testAddition()
 {
@@ -130,6 +83,24 @@ int main()
 	std::cin >> a;
 	
 	std::cout << "You entered: " << a << '\n';
+
+    // Text is parsed straight into the scaled integer, so 5.01 stays exactly 5.01
+    std::istringstream prices{ "5.01\n-0.005\n106.9978\n" };
+    ColumnReader<FixedPoint2> reader{ prices };
+    std::vector<FixedPoint2> column{};
+    reader.readAll(column);
+    for (FixedPoint2 price : column)
+        std::cout << price << ' '; // 5.01 -0.01 107.00
+    std::cout << '\n';
+
+    // Whole-column operations work on the scaled integers directly
+    std::cout << "sum: " << columnSum(column.data(), column.size()) << '\n'; // 112.00
+    auto [lowest, highest]{ columnMinMax(column.data(), column.size()) };
+    std::cout << "min: " << lowest << " max: " << highest << '\n';
+
+    // Saturating mode clamps instead of throwing
+    using Tiny = FixedPoint<2, std::int16_t, Overflow::saturate>;
+    std::cout << Tiny{ 300, 0 } + Tiny{ 30, 0 } << '\n'; // 327.67
  
 	return 0;
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <functional>
+#include <optional>
+#include "teacherregistry.h"
  
 class Teacher
 {
@@ -17,25 +18,44 @@ public:
   const std::string& getName() const { return m_name; }
 };
  
+// A department holds ids from a TeacherRegistry rather than references to Teachers,
+// so checking or changing membership doesn't search a list
 class Department
 {
 private:
-//   const Teacher& m_teacher; // This dept holds only one teacher for simplicity, but it could hold many teachers
-  std::vector<std::reference_wrapper<const Teacher>> m_teachers{};
+  TeacherRegistry& m_registry;
+  TeacherSet m_teachers{};
  
 public:
-  Department(){}
+  explicit Department(TeacherRegistry& registry)
+      : m_registry{ registry }
+  {
+  }
+
   void add(const Teacher& t)
   {
-      m_teachers.push_back(t);
+      m_teachers.insert(m_registry.intern(t.getName()));
+  }
+
+  void remove(const Teacher& t)
+  {
+      if (std::optional<TeacherId> id{ m_registry.find(t.getName()) })
+          m_teachers.erase(*id);
+  }
+
+  bool contains(const Teacher& t) const
+  {
+      std::optional<TeacherId> id{ m_registry.find(t.getName()) };
+      return id && m_teachers.contains(*id);
   }
+
+  const TeacherSet& teachers() const { return m_teachers; }
+  TeacherSet& teachers() { return m_teachers; }
+
   friend std::ostream& operator<<(std::ostream& out, const Department& d)
   {
       out << "Department: ";
-      for (auto teacher : d.m_teachers)
-      {
-          out << teacher.get().getName() << ' ';
-      }
+      d.m_teachers.forEach([&](TeacherId id) { out << d.m_registry.name(id) << ' '; });
       out << '\n';
       return out;
   }
@@ -48,15 +68,29 @@ int main()
   Teacher t2{ "Frank" };
   Teacher t3{ "Beth" };
  
+  TeacherRegistry registry{};
+
   {
     // Create a department and add some Teachers to it
-    Department department{}; // create an empty Department
+    Department department{ registry }; // create an empty Department
  
     department.add(t1);
     department.add(t2);
     department.add(t3);
  
     std::cout << department;
+
+    // Move Frank and Beth to a second department in one go
+    Department science{ registry };
+    science.add(t1);
+    TeacherSet moving{};
+    moving.insert(registry.intern(t2.getName()));
+    moving.insert(registry.intern(t3.getName()));
+    reassign(department.teachers(), science.teachers(), moving);
+
+    std::cout << department << "Science " << science;
+    std::cout << "In both: " << department.teachers().countCommon(science.teachers()) << '\n';
+    std::cout << "Science has Beth: " << std::boolalpha << science.contains(t3) << '\n';
  
   } // department goes out of scope here and is destroyed
  
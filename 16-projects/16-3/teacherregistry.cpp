@@ -0,0 +1,133 @@
+// Member functions of the TeacherRegistry and TeacherSet classes defined here
+
+#include "teacherregistry.h"
+
+#include <algorithm> // for std::equal(), std::max_element(), std::min()
+
+TeacherId TeacherRegistry::intern(std::string_view name)
+{
+    if (const TeacherId* existing{ m_ids.find(name) })
+        return *existing;
+
+    TeacherId id{ static_cast<TeacherId>(m_names.size()) };
+    m_names.emplace_back(name);
+    m_ids[name] = id;
+    return id;
+}
+
+std::optional<TeacherId> TeacherRegistry::find(std::string_view name) const
+{
+    if (const TeacherId* id{ m_ids.find(name) })
+        return *id;
+    return std::nullopt;
+}
+
+void TeacherRegistry::reserve(std::size_t teachers)
+{
+    m_names.reserve(teachers);
+    m_ids.reserve(teachers);
+}
+
+void TeacherSet::insert(const TeacherId* ids, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    // grow once for the whole batch
+    growTo(std::size_t{ *std::max_element(ids, ids + count) } / 64 + 1);
+    for (std::size_t i{ 0 }; i < count; ++i)
+        m_words[ids[i] / 64] |= std::uint64_t{ 1 } << (ids[i] % 64);
+}
+
+void TeacherSet::erase(const TeacherId* ids, std::size_t count)
+{
+    for (std::size_t i{ 0 }; i < count; ++i)
+        erase(ids[i]);
+}
+
+std::size_t TeacherSet::size() const
+{
+    std::size_t count{ 0 };
+    for (std::uint64_t word : m_words)
+        count += static_cast<std::size_t>(__builtin_popcountll(word));
+    return count;
+}
+
+bool TeacherSet::empty() const
+{
+    for (std::uint64_t word : m_words)
+    {
+        if (word != 0)
+            return false;
+    }
+    return true;
+}
+
+// The loops below are plain word-by-word operations that the compiler vectorizes
+
+TeacherSet& TeacherSet::operator|=(const TeacherSet& other)
+{
+    growTo(other.m_words.size());
+    std::uint64_t* words{ m_words.data() };
+    const std::uint64_t* others{ other.m_words.data() };
+    for (std::size_t i{ 0 }; i < other.m_words.size(); ++i)
+        words[i] |= others[i];
+    return *this;
+}
+
+TeacherSet& TeacherSet::operator&=(const TeacherSet& other)
+{
+    std::size_t common{ std::min(m_words.size(), other.m_words.size()) };
+    std::uint64_t* words{ m_words.data() };
+    const std::uint64_t* others{ other.m_words.data() };
+    for (std::size_t i{ 0 }; i < common; ++i)
+        words[i] &= others[i];
+    m_words.resize(common); // nothing past the end of other can be in both
+    return *this;
+}
+
+TeacherSet& TeacherSet::operator-=(const TeacherSet& other)
+{
+    std::size_t common{ std::min(m_words.size(), other.m_words.size()) };
+    std::uint64_t* words{ m_words.data() };
+    const std::uint64_t* others{ other.m_words.data() };
+    for (std::size_t i{ 0 }; i < common; ++i)
+        words[i] &= ~others[i];
+    return *this;
+}
+
+std::size_t TeacherSet::countCommon(const TeacherSet& other) const
+{
+    std::size_t common{ std::min(m_words.size(), other.m_words.size()) };
+    std::size_t count{ 0 };
+    for (std::size_t i{ 0 }; i < common; ++i)
+        count += static_cast<std::size_t>(__builtin_popcountll(m_words[i] & other.m_words[i]));
+    return count;
+}
+
+bool operator==(const TeacherSet& a, const TeacherSet& b)
+{
+    // trailing zero words don't count, so compare the common part and then the rest
+    const TeacherSet& longer{ a.m_words.size() >= b.m_words.size() ? a : b };
+    std::size_t common{ std::min(a.m_words.size(), b.m_words.size()) };
+    if (!std::equal(a.m_words.begin(), a.m_words.begin() + static_cast<std::ptrdiff_t>(common), b.m_words.begin()))
+        return false;
+    for (std::size_t i{ common }; i < longer.m_words.size(); ++i)
+    {
+        if (longer.m_words[i] != 0)
+            return false;
+    }
+    return true;
+}
+
+void reassign(TeacherSet& from, TeacherSet& to, const TeacherSet& teachers)
+{
+    std::size_t common{ std::min(from.m_words.size(), teachers.m_words.size()) };
+    to.growTo(common);
+    for (std::size_t i{ 0 }; i < common; ++i)
+    {
+        std::uint64_t moving{ from.m_words[i] & teachers.m_words[i] };
+        from.m_words[i] &= ~moving;
+        to.m_words[i] |= moving;
+    }
+}
@@ -0,0 +1,113 @@
+// Header file that defines the TeacherRegistry and TeacherSet classes
+//
+// The registry interns teacher names: each distinct name is stored once and gets a
+// small dense id (0, 1, 2, ...). Everything else then works with ids, so a department
+// is a TeacherSet, one bit per id: membership is a single bit test, and union or
+// intersection of two departments is an OR or AND over 64 teachers per word.
+// A TeacherSet takes (highest id + 1) / 8 bytes, whatever its size.
+
+#ifndef TEACHERREGISTRY_H
+#define TEACHERREGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../13-projects/13-9/stringmap.h"
+
+using TeacherId = std::uint32_t;
+
+class TeacherRegistry
+{
+private:
+    std::vector<std::string> m_names{}; // indexed by id
+    StringMap<TeacherId> m_ids{};
+
+public:
+    // The id of name, registering it first if it's new
+    TeacherId intern(std::string_view name);
+
+    // Returns nothing if name was never registered
+    std::optional<TeacherId> find(std::string_view name) const;
+
+    const std::string& name(TeacherId id) const { return m_names[id]; }
+
+    // Number of registered teachers; every id is below this
+    std::size_t size() const { return m_names.size(); }
+
+    void reserve(std::size_t teachers);
+};
+
+class TeacherSet
+{
+private:
+    std::vector<std::uint64_t> m_words{}; // bit id % 64 of word id / 64
+
+    // Makes sure word index exists
+    void growTo(std::size_t words)
+    {
+        if (words > m_words.size())
+            m_words.resize(words, 0);
+    }
+
+public:
+    bool contains(TeacherId id) const
+    {
+        std::size_t word{ id / 64 };
+        return word < m_words.size() && (m_words[word] >> (id % 64) & 1) != 0;
+    }
+
+    void insert(TeacherId id)
+    {
+        growTo(std::size_t{ id } / 64 + 1);
+        m_words[id / 64] |= std::uint64_t{ 1 } << (id % 64);
+    }
+
+    void erase(TeacherId id)
+    {
+        if (id / 64 < m_words.size())
+            m_words[id / 64] &= ~(std::uint64_t{ 1 } << (id % 64));
+    }
+
+    // Bulk versions, for adding or removing thousands of teachers at once
+    void insert(const TeacherId* ids, std::size_t count);
+    void erase(const TeacherId* ids, std::size_t count);
+
+    void clear() { m_words.clear(); }
+
+    // Number of teachers in the set (a popcount per word, so O(highest id / 64))
+    std::size_t size() const;
+    bool empty() const;
+
+    TeacherSet& operator|=(const TeacherSet& other); // union
+    TeacherSet& operator&=(const TeacherSet& other); // intersection
+    TeacherSet& operator-=(const TeacherSet& other); // difference
+
+    friend TeacherSet operator|(TeacherSet a, const TeacherSet& b) { return a |= b; }
+    friend TeacherSet operator&(TeacherSet a, const TeacherSet& b) { return a &= b; }
+    friend TeacherSet operator-(TeacherSet a, const TeacherSet& b) { return a -= b; }
+
+    // Size of the intersection, without building it
+    std::size_t countCommon(const TeacherSet& other) const;
+
+    friend bool operator==(const TeacherSet& a, const TeacherSet& b);
+    friend bool operator!=(const TeacherSet& a, const TeacherSet& b) { return !(a == b); }
+
+    // Calls function(id) for every member, in increasing id order
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        for (std::size_t word{ 0 }; word < m_words.size(); ++word)
+        {
+            for (std::uint64_t bits{ m_words[word] }; bits != 0; bits &= bits - 1)
+                function(static_cast<TeacherId>(word * 64 + static_cast<std::size_t>(__builtin_ctzll(bits))));
+        }
+    }
+
+    // Moves the members of teachers that are in from over to to, a word at a time
+    friend void reassign(TeacherSet& from, TeacherSet& to, const TeacherSet& teachers);
+};
+
+#endif
@@ -0,0 +1,166 @@
+// Member functions of the Arena and Pool classes defined here
+
+#include "allocators.h"
+
+#include <cstdint>
+
+namespace
+{
+    // Every block and slab is carved from memory aligned like this
+    constexpr std::size_t baseAlignment{ alignof(std::max_align_t) };
+
+    constexpr std::size_t roundUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+Arena::Arena(std::size_t blockSize)
+    : m_blockSize{ blockSize }
+{
+}
+
+Arena::~Arena()
+{
+    while (m_blocks)
+    {
+        Block* next{ m_blocks->next };
+        ::operator delete(m_blocks);
+        m_blocks = next;
+    }
+}
+
+void Arena::addBlock(std::size_t minimumBytes)
+{
+    std::size_t size{ minimumBytes > m_blockSize ? minimumBytes : m_blockSize };
+    std::size_t headerSize{ roundUp(sizeof(Block), baseAlignment) };
+
+    Block* block{ static_cast<Block*>(::operator new(headerSize + size)) };
+    block->next = m_blocks;
+    block->size = size;
+    m_blocks = block;
+
+    m_current = reinterpret_cast<char*>(block) + headerSize;
+    m_end = m_current + size;
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::uintptr_t current{ reinterpret_cast<std::uintptr_t>(m_current) };
+    std::size_t padding{ roundUp(current, alignment) - current };
+
+    if (!m_current || padding + bytes > static_cast<std::size_t>(m_end - m_current))
+    {
+        // alignment beyond baseAlignment may need padding at the start of the new block too
+        addBlock(bytes + (alignment > baseAlignment ? alignment : 0));
+        current = reinterpret_cast<std::uintptr_t>(m_current);
+        padding = roundUp(current, alignment) - current;
+    }
+
+    char* result{ m_current + padding };
+    m_current = result + bytes;
+    return result;
+}
+
+void Arena::reset()
+{
+    if (!m_blocks)
+        return;
+
+    // keep the largest block (an oversized one made for a big allocation isn't
+    // necessarily the newest), so the next fill doesn't have to allocate it again
+    Block* keep{ m_blocks };
+    for (Block* block{ m_blocks->next }; block; block = block->next)
+    {
+        if (block->size > keep->size)
+            keep = block;
+    }
+
+    while (m_blocks)
+    {
+        Block* next{ m_blocks->next };
+        if (m_blocks != keep)
+            ::operator delete(m_blocks);
+        m_blocks = next;
+    }
+    keep->next = nullptr;
+    m_blocks = keep;
+
+    m_current = reinterpret_cast<char*>(keep) + roundUp(sizeof(Block), baseAlignment);
+    m_end = m_current + keep->size;
+}
+
+Pool::Pool(std::size_t slabSize)
+    : m_slabSize{ slabSize < maxClassSize ? maxClassSize : slabSize }
+{
+}
+
+Pool::~Pool()
+{
+    while (m_slabs)
+    {
+        Slab* next{ m_slabs->next };
+        ::operator delete(m_slabs);
+        m_slabs = next;
+    }
+}
+
+int Pool::sizeClass(std::size_t bytes)
+{
+    if (bytes <= minClassSize)
+        return 0;
+    // index of the smallest power of two >= bytes, counted from minClassSize
+    return 64 - __builtin_clzll(static_cast<unsigned long long>(bytes - 1)) - 4;
+}
+
+void Pool::refill(int sizeClass)
+{
+    std::size_t slotSize{ minClassSize << sizeClass };
+    std::size_t headerSize{ roundUp(sizeof(Slab), baseAlignment) };
+
+    Slab* slab{ static_cast<Slab*>(::operator new(headerSize + m_slabSize)) };
+    slab->next = m_slabs;
+    m_slabs = slab;
+
+    // thread every slot of the new slab onto the free list
+    char* first{ reinterpret_cast<char*>(slab) + headerSize };
+    std::size_t slotCount{ m_slabSize / slotSize };
+    for (std::size_t i{ slotCount }; i > 0; --i)
+    {
+        FreeSlot* slot{ reinterpret_cast<FreeSlot*>(first + (i - 1) * slotSize) };
+        slot->next = m_free[sizeClass];
+        m_free[sizeClass] = slot;
+    }
+}
+
+void* Pool::allocate(std::size_t bytes, std::size_t alignment)
+{
+    // slots are only guaranteed baseAlignment
+    if (bytes > maxClassSize || alignment > baseAlignment)
+        return ::operator new(bytes, std::align_val_t{ alignment });
+
+    int index{ sizeClass(bytes) };
+    if (!m_free[index])
+        refill(index);
+
+    FreeSlot* slot{ m_free[index] };
+    m_free[index] = slot->next;
+    return slot;
+}
+
+void Pool::deallocate(void* pointer, std::size_t bytes, std::size_t alignment) noexcept
+{
+    if (!pointer)
+        return;
+
+    if (bytes > maxClassSize || alignment > baseAlignment)
+    {
+        ::operator delete(pointer, std::align_val_t{ alignment });
+        return;
+    }
+
+    int index{ sizeClass(bytes) };
+    FreeSlot* slot{ static_cast<FreeSlot*>(pointer) };
+    slot->next = m_free[index];
+    m_free[index] = slot;
+}
@@ -0,0 +1,158 @@
+// Header file that defines the Arena and Pool memory resources and their allocators
+//
+// Arena hands out memory by bumping a pointer through large blocks and frees it all
+// at once, which suits scratch arrays that die together at the end of a request.
+// Pool keeps a free list per power-of-two size class, so memory that is freed gets
+// reused by the next allocation of a similar size without going back to the heap.
+// Neither is thread-safe: give each thread (or request) its own.
+// ArenaAllocator<T> and PoolAllocator<T> adapt them to the standard Allocator
+// interface, so they work with Array and with the standard containers.
+
+#ifndef ALLOCATORS_H
+#define ALLOCATORS_H
+
+#include <cstddef>
+#include <new> // for std::bad_array_new_length
+#include <type_traits>
+
+class Arena
+{
+private:
+    struct Block
+    {
+        Block* next;
+        std::size_t size; // bytes after the header
+    };
+
+    std::size_t m_blockSize{};
+    Block* m_blocks{}; // most recent first
+    char* m_current{};
+    char* m_end{};
+
+    void addBlock(std::size_t minimumBytes);
+
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    // Frees everything allocated so far in one go. The largest block is kept, so an
+    // arena reset once per request settles into not touching the heap at all when a
+    // request's allocations fit in that block.
+    void reset();
+};
+
+class Pool
+{
+public:
+    // Size classes are 16, 32, 64, ... 4096 bytes; bigger requests go straight to the heap
+    static constexpr std::size_t minClassSize{ 16 };
+    static constexpr std::size_t maxClassSize{ 4096 };
+    static constexpr int classCount{ 9 };
+
+private:
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    struct Slab
+    {
+        Slab* next;
+    };
+
+    std::size_t m_slabSize{};
+    FreeSlot* m_free[classCount]{};
+    Slab* m_slabs{};
+
+    static int sizeClass(std::size_t bytes);
+    void refill(int sizeClass);
+
+public:
+    explicit Pool(std::size_t slabSize = 64 * 1024);
+    ~Pool();
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // Pass deallocate() the same bytes and alignment that were passed to allocate()
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+    void deallocate(void* pointer, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+};
+
+namespace allocators_detail
+{
+    template <typename T>
+    std::size_t bytesFor(std::size_t count)
+    {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        return count * sizeof(T);
+    }
+}
+
+// deallocate() does nothing: the memory comes back when the arena is reset or destroyed
+template <typename T>
+class ArenaAllocator
+{
+private:
+    Arena* m_arena;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    ArenaAllocator(Arena& arena) noexcept : m_arena{ &arena } {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena{ other.arena() } {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(m_arena->allocate(allocators_detail::bytesFor<T>(count), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    Arena* arena() const { return m_arena; }
+
+    friend bool operator==(const ArenaAllocator& a, const ArenaAllocator& b) { return a.m_arena == b.m_arena; }
+    friend bool operator!=(const ArenaAllocator& a, const ArenaAllocator& b) { return a.m_arena != b.m_arena; }
+};
+
+template <typename T>
+class PoolAllocator
+{
+private:
+    Pool* m_pool;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    PoolAllocator(Pool& pool) noexcept : m_pool{ &pool } {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : m_pool{ other.pool() } {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(m_pool->allocate(allocators_detail::bytesFor<T>(count), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        m_pool->deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    Pool* pool() const { return m_pool; }
+
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator& b) { return a.m_pool == b.m_pool; }
+    friend bool operator!=(const PoolAllocator& a, const PoolAllocator& b) { return a.m_pool != b.m_pool; }
+};
+
+#endif
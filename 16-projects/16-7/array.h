@@ -0,0 +1,308 @@
+// Header file that defines the Array<T, Allocator> class template
+//
+// A growable array that gets its memory from an allocator instead of new[]/delete[]:
+// std::allocator by default, or an ArenaAllocator/PoolAllocator (see allocators.h) to
+// keep short-lived arrays off the global heap. Up to 64 bytes of elements (16 ints)
+// live inside the object itself, capacity doubles as the array fills up, and
+// assigning a list that fits reuses the storage that's already there.
+
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include <cassert> // for assert()
+#include <initializer_list> // for std::initializer_list
+#include <memory> // for std::allocator, std::allocator_traits
+#include <type_traits>
+#include <utility> // for std::move(), std::forward()
+
+template <typename T, typename Allocator = std::allocator<T>>
+class Array
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static constexpr int smallCapacity{ sizeof(T) <= 64 ? static_cast<int>(64 / sizeof(T)) : 1 };
+
+private:
+    using Traits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename Traits::value_type, T>, "Allocator must allocate T");
+
+    Allocator m_allocator;
+    int m_length{};
+    int m_capacity{ smallCapacity };
+    T* m_data{ smallData() }; // points at m_small until the array outgrows it
+    alignas(T) unsigned char m_small[smallCapacity * sizeof(T)];
+
+    T* smallData() { return reinterpret_cast<T*>(m_small); }
+    bool isSmall() const { return m_data == reinterpret_cast<const T*>(m_small); }
+
+    // Gives heap storage back to the allocator (the elements must already be destroyed)
+    void freeStorage() noexcept
+    {
+        if (!isSmall())
+            Traits::deallocate(m_allocator, m_data, static_cast<std::size_t>(m_capacity));
+        m_data = smallData();
+        m_capacity = smallCapacity;
+    }
+
+    // Moves the elements to data (copying if T's move could throw) and destroys the originals
+    void relocateTo(T* data)
+    {
+        int constructed{ 0 };
+        try
+        {
+            for (; constructed < m_length; ++constructed)
+                Traits::construct(m_allocator, data + constructed, std::move_if_noexcept(m_data[constructed]));
+        }
+        catch (...)
+        {
+            for (int i{ 0 }; i < constructed; ++i)
+                Traits::destroy(m_allocator, data + i);
+            throw;
+        }
+
+        for (int i{ 0 }; i < m_length; ++i)
+            Traits::destroy(m_allocator, m_data + i);
+    }
+
+    void reallocate(int capacity)
+    {
+        T* data{ Traits::allocate(m_allocator, static_cast<std::size_t>(capacity)) };
+        try
+        {
+            relocateTo(data);
+        }
+        catch (...)
+        {
+            Traits::deallocate(m_allocator, data, static_cast<std::size_t>(capacity));
+            throw;
+        }
+        freeStorage();
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    int grownCapacity(int needed) const { return needed > m_capacity * 2 ? needed : m_capacity * 2; }
+
+    // Takes over other's elements and leaves it empty; we must be empty with no heap storage,
+    // and other's memory must be ours to free (equal or propagated allocators)
+    void takeFrom(Array& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (other.isSmall())
+        {
+            // the elements live inside other, so they have to be moved one by one
+            for (int i{ 0 }; i < other.m_length; ++i)
+                Traits::construct(m_allocator, smallData() + i, std::move(other.m_data[i]));
+            m_length = other.m_length;
+            other.clear();
+        }
+        else
+        {
+            // steal the heap buffer and point other back at its own small buffer
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_length = other.m_length;
+            other.m_data = other.smallData();
+            other.m_capacity = smallCapacity;
+            other.m_length = 0;
+        }
+    }
+
+    template <typename It>
+    void assign(It first, int length)
+    {
+        clear();
+        if (length > m_capacity)
+        {
+            T* data{ Traits::allocate(m_allocator, static_cast<std::size_t>(length)) };
+            freeStorage();
+            m_data = data;
+            m_capacity = length;
+        }
+        for (; m_length < length; ++m_length, ++first)
+            Traits::construct(m_allocator, m_data + m_length, *first);
+    }
+
+public:
+    Array() = default;
+
+    explicit Array(const Allocator& allocator)
+        : m_allocator{ allocator }
+    {
+    }
+
+    Array(int length, const Allocator& allocator = Allocator())
+        : m_allocator{ allocator }
+    {
+        resize(length);
+    }
+
+    Array(std::initializer_list<T> list, const Allocator& allocator = Allocator())
+        : m_allocator{ allocator }
+    {
+        assign(list.begin(), static_cast<int>(list.size()));
+    }
+
+    Array(const Array& other)
+        : m_allocator{ Traits::select_on_container_copy_construction(other.m_allocator) }
+    {
+        assign(other.m_data, other.m_length);
+    }
+
+    Array(Array&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : m_allocator{ other.m_allocator }
+    {
+        takeFrom(other);
+    }
+
+    ~Array()
+    {
+        clear();
+        freeStorage();
+    }
+
+    Array& operator=(const Array& other)
+    {
+        if (this != &other)
+        {
+            if constexpr (Traits::propagate_on_container_copy_assignment::value)
+            {
+                if (m_allocator != other.m_allocator)
+                {
+                    clear();
+                    freeStorage();
+                }
+                m_allocator = other.m_allocator;
+            }
+            assign(other.m_data, other.m_length);
+        }
+        return *this;
+    }
+
+    Array& operator=(Array&& other) noexcept(Traits::propagate_on_container_move_assignment::value
+        && std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &other)
+            return *this;
+
+        clear();
+        if (Traits::propagate_on_container_move_assignment::value || m_allocator == other.m_allocator)
+        {
+            freeStorage();
+            if constexpr (Traits::propagate_on_container_move_assignment::value)
+                m_allocator = other.m_allocator;
+            takeFrom(other);
+        }
+        else
+        {
+            // other's memory belongs to a different allocator, so only its elements can move
+            reserve(other.m_length);
+            for (; m_length < other.m_length; ++m_length)
+                Traits::construct(m_allocator, m_data + m_length, std::move(other.m_data[m_length]));
+            other.clear();
+        }
+        return *this;
+    }
+
+    // Reuses the current storage when the list fits
+    Array& operator=(std::initializer_list<T> list)
+    {
+        assign(list.begin(), static_cast<int>(list.size()));
+        return *this;
+    }
+
+    T& operator[](int index)
+    {
+        assert(index >= 0 && index < m_length);
+        return m_data[index];
+    }
+
+    const T& operator[](int index) const
+    {
+        assert(index >= 0 && index < m_length);
+        return m_data[index];
+    }
+
+    int getLength() const { return m_length; }
+    int getCapacity() const { return m_capacity; }
+    const Allocator& getAllocator() const { return m_allocator; }
+
+    // Makes room for at least capacity elements without changing the length
+    void reserve(int capacity)
+    {
+        if (capacity > m_capacity)
+            reallocate(capacity);
+    }
+
+    // New elements are value-initialized (zero for ints)
+    void resize(int length)
+    {
+        assert(length >= 0);
+        if (length > m_capacity)
+            reallocate(grownCapacity(length));
+        for (; m_length < length; ++m_length)
+            Traits::construct(m_allocator, m_data + m_length);
+        while (m_length > length)
+            Traits::destroy(m_allocator, m_data + --m_length);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (m_length < m_capacity)
+        {
+            Traits::construct(m_allocator, m_data + m_length, std::forward<Args>(args)...);
+            return m_data[m_length++];
+        }
+
+        // construct the new element before moving the old ones, since args may refer to one of them
+        int capacity{ grownCapacity(m_length + 1) };
+        T* data{ Traits::allocate(m_allocator, static_cast<std::size_t>(capacity)) };
+        try
+        {
+            Traits::construct(m_allocator, data + m_length, std::forward<Args>(args)...);
+            try
+            {
+                relocateTo(data);
+            }
+            catch (...)
+            {
+                Traits::destroy(m_allocator, data + m_length);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            Traits::deallocate(m_allocator, data, static_cast<std::size_t>(capacity));
+            throw;
+        }
+        freeStorage();
+        m_data = data;
+        m_capacity = capacity;
+        return m_data[m_length++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        assert(m_length > 0);
+        Traits::destroy(m_allocator, m_data + --m_length);
+    }
+
+    // Empties the array but keeps its storage
+    void clear() noexcept
+    {
+        while (m_length > 0)
+            Traits::destroy(m_allocator, m_data + --m_length);
+    }
+
+    T* begin() { return m_data; }
+    T* end() { return m_data + m_length; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_length; }
+};
+
+#endif
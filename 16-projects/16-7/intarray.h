@@ -0,0 +1,13 @@
+// Header file that defines IntArray
+//
+// IntArray is Array<int> (see array.h): it grows by doubling, keeps up to 16 ints
+// inside the object, and can be handed an arena or pool allocator.
+
+#ifndef INTARRAY_H
+#define INTARRAY_H
+
+#include "array.h"
+
+using IntArray = Array<int>;
+
+#endif
@@ -1,70 +1,8 @@
-#include <cassert> // for assert()
-#include <initializer_list> // for std::initializer_list
-#include <iostream>
- 
-class IntArray
-{
-private:
-	int m_length {};
-	int* m_data {};
- 
-public:
-	IntArray() = default;
- 
-	IntArray(int length)
-		: m_length{ length }
-		, m_data{ new int[length]{} }
-	{
- 
-	}
- 
-	IntArray(std::initializer_list<int> list) // allow IntArray to be initialized via list initialization
-		: IntArray(static_cast<int>(list.size())) // use delegating constructor to set up initial array
-	{
-		// Now initialize our array from the list
-		int count{ 0 };
-		for (auto element : list)
-		{
-			m_data[count] = element;
-			++count;
-		}
-	}
- 
-	~IntArray()
-	{
-		delete[] m_data;
-		// we don't need to set m_data to null or m_length to 0 here, since the object will be destroyed immediately after this function anyway
-	}
- 
-	IntArray(const IntArray&) = delete; // to avoid shallow copies
-	IntArray& operator=(const IntArray& list) = delete; // to avoid shallow copies
-	
-	int& operator[](int index)
-	{
-		assert(index >= 0 && index < m_length);
-		return m_data[index];
-	}
- 
-	int getLength() const { return m_length; }
-
-	IntArray& operator=(std::initializer_list<int> list)
-	{
-		// delete existing data if applicable
-		if (m_data) delete[] m_data;
+#include "allocators.h"
+#include "intarray.h"
 
-		// update length and data
-		m_length = list.size();
-		m_data = new int[m_length]{};
-		int count{ 0 };
-		for (int element : list)
-		{
-			m_data[count] = element;
-			++count;
-		}
-		return *this;
-	}
-};
-	
+#include <iostream>
+#include <utility> // for std::move()
 
 int main()
 {
@@ -80,6 +18,38 @@ int main()
 		std::cout << array[count] << ' ';
  
 	std::cout << '\n';
+
+	// a shorter list fits in the storage we already have, so nothing is reallocated
+	array = { 2, 4 };
+	std::cout << "length " << array.getLength() << ", capacity " << array.getCapacity() << '\n';
+
+	// growing past the small buffer doubles the capacity, and moving just hands it over
+	IntArray squares;
+	for (int i{ 0 }; i < 100; ++i)
+		squares.push_back(i * i);
+	IntArray moved{ std::move(squares) };
+	std::cout << "length " << moved.getLength() << ", capacity " << moved.getCapacity() << ", last " << moved[99] << '\n';
+
+	// scratch arrays for one request come out of an arena and are all freed by reset()
+	Arena arena;
+	for (int request{ 0 }; request < 3; ++request)
+	{
+		// scratch must be gone before reset(), or its destructor would touch freed memory
+		{
+			Array<int, ArenaAllocator<int>> scratch{ arena };
+			for (int i{ 0 }; i < 1000; ++i)
+				scratch.push_back(request + i);
+			std::cout << "request " << request << " scratch sum " << scratch[0] + scratch[999] << '\n';
+		}
+		arena.reset();
+	}
+
+	// a pool recycles freed arrays of a similar size instead of going back to the heap
+	Pool pool;
+	Array<double, PoolAllocator<double>> first(100, pool);
+	Array<double, PoolAllocator<double>> second{ first };
+	second[0] = 1.5;
+	std::cout << "pooled " << first.getLength() << " + " << second.getLength() << " doubles, second[0] " << second[0] << '\n';
  
 	return 0;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <cmath> // for std::abs()
 #include <algorithm> // for std::max()
 #include <iostream>
+#include <vector>
+#include "tolerance.h"
 
 bool approximatelyEqual(double a, double b, double epsilon)
 {
@@ -26,5 +28,15 @@ int main()
 {
     double a = 0.1 + 0.1 + 0.1 + 0.1 + 0.1 + 0.1 + 0.1 + 0.1 + 0.1 + 0.1;
     std::cout << approximatelyEqualRel(a - 1.0, 0.0, 1e-8) << '\n';
+
+    // The same kind of check over whole arrays at once
+    std::vector<double> expected(1'000'000, 1.0);
+    std::vector<double> actual(expected.size(), a);
+    actual[123] = 1.5;
+    actual[456'789] = 0.5;
+
+    CompareResult diff{ compareArrays(expected.data(), actual.data(), expected.size(), { 1e-12, 1e-8, 4 }) };
+    std::cout << diff.mismatchCount << " mismatches, first at " << diff.firstMismatches[0]
+              << ", max error " << diff.maxAbsError << " at " << diff.maxAbsErrorIndex << '\n';
     return 0;
 }
\ No newline at end of file
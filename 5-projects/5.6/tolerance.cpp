@@ -0,0 +1,134 @@
+// Bulk floating-point comparison functions defined here
+
+#include "tolerance.h"
+
+#include <algorithm> // for std::min()
+#include <cmath>     // for std::abs()
+#include <cstring>   // for std::memcpy()
+#include <limits>
+
+namespace
+{
+    // Pairs are checked a block at a time, and the mismatch flags are only scanned for
+    // indices when the block actually had a mismatch
+    constexpr std::size_t blockSize{ 1024 };
+
+    // Maps a double's bits onto an integer line that is ordered the same way as the
+    // doubles themselves, so the distance between two of them counts the ULPs between
+    std::int64_t orderedBits(double value)
+    {
+        std::int64_t bits{};
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits < 0 ? std::numeric_limits<std::int64_t>::min() - bits : bits;
+    }
+
+    std::uint64_t orderedDistance(std::int64_t a, std::int64_t b)
+    {
+        return a > b ? static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b)
+                     : static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+    }
+
+    struct BlockLimits
+    {
+        double absEpsilon;
+        double relEpsilon;
+        std::uint64_t maxUlps;
+        bool nansEqual;
+    };
+
+    // Sets mismatch[i] for each pair in the block that is out of tolerance and returns
+    // how many there were. The loop is branch-free so the compiler can vectorize it.
+    std::size_t compareBlock(const double* a, const double* b, std::size_t length, BlockLimits limits,
+                             unsigned char* mismatch, double& maxError, std::uint64_t& maxUlps)
+    {
+        std::size_t mismatches{ 0 };
+        std::int64_t blockMaxErrorBits{ 0 };
+        std::uint64_t blockMaxUlps{ 0 };
+
+        for (std::size_t i{ 0 }; i < length; ++i)
+        {
+            double x{ a[i] };
+            double y{ b[i] };
+
+            bool xNan{ x != x };
+            bool yNan{ y != y };
+            bool anyNan{ xNan || yNan };
+
+            double diff{ std::abs(x - y) };
+            double scale{ std::max(std::abs(x), std::abs(y)) };
+            std::uint64_t ulps{ orderedDistance(orderedBits(x), orderedBits(y)) };
+
+            bool match{ static_cast<bool>((x == y)
+                                          | (diff <= limits.absEpsilon)
+                                          | (diff <= scale * limits.relEpsilon)
+                                          | (!anyNan & (ulps <= limits.maxUlps))
+                                          | (limits.nansEqual & xNan & yNan)) };
+
+            mismatch[i] = !match;
+            mismatches += !match;
+
+            // Non-negative doubles order the same way as their bit patterns, so the max error
+            // is tracked as an integer max, which vectorizes where a double max with NaN
+            // semantics can't. inf - inf is NaN, so NaN diffs are skipped along with NaN inputs.
+            std::int64_t errorBits{ diff == diff ? orderedBits(diff) : 0 };
+            blockMaxErrorBits = std::max(blockMaxErrorBits, errorBits);
+            blockMaxUlps = std::max(blockMaxUlps, ulps & (static_cast<std::uint64_t>(anyNan) - 1)); // 0 if anyNan
+        }
+
+        std::memcpy(&maxError, &blockMaxErrorBits, sizeof(maxError));
+        maxUlps = blockMaxUlps;
+        return mismatches;
+    }
+}
+
+std::uint64_t ulpDistance(double a, double b)
+{
+    return orderedDistance(orderedBits(a), orderedBits(b));
+}
+
+CompareResult compareArrays(const double* a, const double* b, std::size_t count,
+                            const Tolerance& tolerance, std::size_t maxReported)
+{
+    CompareResult result{};
+    result.firstMismatches.reserve(std::min(count, maxReported));
+
+    const BlockLimits limits{ tolerance.absEpsilon, tolerance.relEpsilon, tolerance.maxUlps, tolerance.nansEqual };
+    unsigned char mismatch[blockSize];
+
+    for (std::size_t begin{ 0 }; begin < count; begin += blockSize)
+    {
+        std::size_t length{ std::min(blockSize, count - begin) };
+        const double* blockA{ a + begin };
+        const double* blockB{ b + begin };
+
+        double blockMaxError{ 0.0 };
+        std::uint64_t blockMaxUlps{ 0 };
+        std::size_t blockMismatches{ compareBlock(blockA, blockB, length, limits, mismatch, blockMaxError, blockMaxUlps) };
+
+        if (blockMaxError > result.maxAbsError)
+        {
+            result.maxAbsError = blockMaxError;
+            for (std::size_t i{ 0 }; i < length; ++i)
+            {
+                if (std::abs(blockA[i] - blockB[i]) == blockMaxError)
+                {
+                    result.maxAbsErrorIndex = begin + i;
+                    break;
+                }
+            }
+        }
+        result.maxUlpError = std::max(result.maxUlpError, blockMaxUlps);
+
+        if (blockMismatches > 0)
+        {
+            for (std::size_t i{ 0 }; i < length && result.firstMismatches.size() < maxReported; ++i)
+            {
+                if (mismatch[i])
+                    result.firstMismatches.push_back(begin + i);
+            }
+            result.mismatchCount += blockMismatches;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,39 @@
+// Header file for bulk floating-point comparison of two arrays against tolerances
+//
+// The per-element rule matches approximatelyEqualAbsRel() in main.cpp, plus an
+// optional ULP (units in the last place) rule: a pair matches if it is within the
+// absolute tolerance, OR within the relative tolerance, OR at most maxUlps apart.
+
+#ifndef TOLERANCE_H
+#define TOLERANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Tolerance
+{
+    double absEpsilon{ 0.0 };
+    double relEpsilon{ 0.0 };
+    std::uint64_t maxUlps{ 0 };
+    bool nansEqual{ true }; // treat NaN == NaN as a match, as golden files usually intend
+};
+
+struct CompareResult
+{
+    std::size_t mismatchCount{};
+    std::vector<std::size_t> firstMismatches{}; // indices, in increasing order
+    double maxAbsError{};                       // over pairs that don't involve NaN
+    std::size_t maxAbsErrorIndex{};
+    std::uint64_t maxUlpError{};                // over pairs that don't involve NaN
+};
+
+// Distance between a and b in representable doubles: 0 for equal values (including
+// +0.0 and -0.0), 1 for neighbours, and so on across zero
+std::uint64_t ulpDistance(double a, double b);
+
+// Compares a[0..count) with b[0..count) and reports up to maxReported mismatch indices
+CompareResult compareArrays(const double* a, const double* b, std::size_t count,
+                            const Tolerance& tolerance, std::size_t maxReported = 16);
+
+#endif
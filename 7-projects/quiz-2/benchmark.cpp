@@ -0,0 +1,53 @@
+// Timing for countPrimes() and PrimeSieve, kept out of main.cpp so the quiz stays quick
+//
+// Build: g++ -std=c++17 -O2 -pthread benchmark.cpp primes.cpp -o benchmark
+// Run:   ./benchmark [limit]    (default 10^9)
+//
+// countPrimes() is timed on one thread and on every hardware thread. It only ever holds
+// one segment per thread, while PrimeSieve keeps every bit, so the sieve is built to a
+// tenth of the limit to keep its memory modest.
+
+#include "primes.h"
+
+#include <algorithm> // for std::max()
+#include <chrono>
+#include <cstdint>
+#include <cstdlib> // for std::strtoull()
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    template <typename Function>
+    double secondsFor(Function function)
+    {
+        auto start{ std::chrono::steady_clock::now() };
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void timeCountPrimes(std::uint64_t limit, unsigned threadCount)
+    {
+        std::uint64_t count{};
+        double seconds{ secondsFor([&]() { count = countPrimes(limit, threadCount); }) };
+        std::cout << "countPrimes(" << limit << ") on " << threadCount << " thread(s): " << count
+                  << " primes in " << seconds << "s\n"; // 50847534 below 10^9
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::uint64_t limit{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000'000 };
+    unsigned threadCount{ std::max(1u, std::thread::hardware_concurrency()) };
+
+    timeCountPrimes(limit, 1);
+    if (threadCount > 1)
+        timeCountPrimes(limit, threadCount);
+
+    std::uint64_t sieveLimit{ limit / 10 };
+    std::uint64_t count{};
+    double seconds{ secondsFor([&]() { count = PrimeSieve{ sieveLimit, threadCount }.count(); }) };
+    std::cout << "PrimeSieve(" << sieveLimit << ").count(): " << count << " primes in " << seconds << "s\n";
+
+    return 0;
+}
@@ -1,26 +1,6 @@
 #include <iostream>
 #include <cassert>
- 
-bool isPrime(int x)
-{
-    // std::cout << x;
-    if (x == 0 || x == 1)
-    {
-        return false;
-    }
-    for (int count{ 2 }; count < x; ++count)
-    {
-        if (count == 1)
-        {
-            continue;
-        }
-        if ((x % count) == 0)
-        {
-            return false;
-        }
-    }
-    return true;
-}
+#include "primes.h"
  
 int main()
 {
@@ -42,6 +22,10 @@ int main()
     assert(!isPrime(99));
     assert(!isPrime(99));
     assert(isPrime(13417));
+    assert(isPrime(18446744073709551557u)); // largest 64-bit prime
+    assert(!isPrime(3215031751u));          // strong pseudoprime to bases 2, 3, 5 and 7
+ 
+    assert(countPrimes(1'000'000) == 78498);
  
     std::cout << "Success!\n";
  
@@ -0,0 +1,332 @@
+// Prime number functions and PrimeSieve member functions defined here
+
+#include "primes.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+    // The eight residues mod 30 that are coprime to 2, 3 and 5, one per bit of a byte
+    constexpr std::array<std::uint8_t, 8> wheelResidues{ 1, 7, 11, 13, 17, 19, 23, 29 };
+
+    // Bit index of each residue mod 30, or -1 if numbers with that residue are
+    // divisible by 2, 3 or 5
+    constexpr std::array<std::int8_t, 30> residueBit{
+        -1, 0, -1, -1, -1, -1, -1, 1, -1, -1, -1, 2, -1, 3, -1,
+        -1, -1, 4, -1, 5, -1, -1, -1, 6, -1, -1, -1, -1, -1, 7,
+    };
+
+    // Segment size in bytes. 32 KiB of bits covers 983,040 numbers and fits in L1.
+    constexpr std::uint64_t segmentBytes{ 32 * 1024 };
+
+    // Below this a single thread is faster than starting more
+    constexpr std::uint64_t minBytesPerThread{ 4 * segmentBytes };
+
+    // One arithmetic progression of multiples to cross off: the multiples p * q of a
+    // sieving prime p with q in a fixed residue class mod 30 all land on the same bit,
+    // and consecutive ones are exactly p bytes apart
+    struct Crossing
+    {
+        std::uint64_t nextByte;
+        std::uint32_t step;
+        std::uint8_t clearMask;
+    };
+
+    std::uint64_t integerSqrt(std::uint64_t n)
+    {
+        std::uint64_t root{ static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n))) };
+        while (root * root > n)
+            --root;
+        while ((root + 1) * (root + 1) <= n)
+            ++root;
+        return root;
+    }
+
+    // Primes from 7 up to and including limit, by a plain sieve (limit is at most 2^32)
+    std::vector<std::uint32_t> sievingPrimes(std::uint64_t limit)
+    {
+        std::vector<bool> composite(limit + 1);
+        std::vector<std::uint32_t> primes{};
+
+        for (std::uint64_t n{ 2 }; n <= limit; ++n)
+        {
+            if (composite[n])
+                continue;
+            if (n >= 7)
+                primes.push_back(static_cast<std::uint32_t>(n));
+            for (std::uint64_t multiple{ n * n }; multiple <= limit; multiple += n)
+                composite[multiple] = true;
+        }
+
+        return primes;
+    }
+
+    // First multiple of each sieving prime to cross off at or after byte firstByte
+    std::vector<Crossing> startCrossings(const std::vector<std::uint32_t>& primes, std::uint64_t firstByte)
+    {
+        std::vector<Crossing> crossings{};
+        crossings.reserve(primes.size() * wheelResidues.size());
+
+        std::uint64_t low{ firstByte * 30 };
+        for (std::uint32_t p : primes)
+        {
+            // Smaller multiples of p were already crossed off by smaller primes
+            std::uint64_t qMin{ std::max<std::uint64_t>(p, (low + p - 1) / p) };
+
+            for (std::uint8_t residue : wheelResidues)
+            {
+                std::uint64_t q{ qMin + (residue + 30 - qMin % 30) % 30 };
+                std::uint64_t multiple{ p * q };
+                crossings.push_back({ multiple / 30, p,
+                                      static_cast<std::uint8_t>(~(1u << residueBit[multiple % 30])) });
+            }
+        }
+
+        return crossings;
+    }
+
+    // Sieves bytes [firstByte, endByte) one segment at a time. bitsFor(segment) says
+    // where to write the segment starting at byte `segment`, and done(bits, segment,
+    // length) is called once it has been sieved.
+    template <typename BitsFor, typename Done>
+    void sieveSegments(std::uint64_t firstByte, std::uint64_t endByte, const std::vector<std::uint32_t>& primes,
+                       BitsFor bitsFor, Done done)
+    {
+        std::vector<Crossing> crossings{ startCrossings(primes, firstByte) };
+
+        for (std::uint64_t segment{ firstByte }; segment < endByte; segment += segmentBytes)
+        {
+            std::uint64_t segmentEnd{ std::min(endByte, segment + segmentBytes) };
+            std::uint8_t* bits{ bitsFor(segment) };
+
+            std::fill(bits, bits + (segmentEnd - segment), std::uint8_t{ 0xFF });
+            if (segment == 0)
+                bits[0] &= 0xFE; // 1 is not prime
+
+            for (Crossing& crossing : crossings)
+            {
+                std::uint64_t byte{ crossing.nextByte };
+                for (; byte < segmentEnd; byte += crossing.step)
+                    bits[byte - segment] &= crossing.clearMask;
+                crossing.nextByte = byte;
+            }
+
+            done(bits, segment, segmentEnd - segment);
+        }
+    }
+
+    // Mask of the bits in byte `byte` whose numbers are below limit
+    std::uint8_t bitsBelow(std::uint64_t byte, std::uint64_t limit)
+    {
+        std::uint8_t mask{ 0 };
+        for (std::size_t bit{ 0 }; bit < wheelResidues.size(); ++bit)
+        {
+            if (byte * 30 + wheelResidues[bit] < limit)
+                mask |= static_cast<std::uint8_t>(1u << bit);
+        }
+        return mask;
+    }
+
+    // Primes below limit that the wheel doesn't store
+    std::uint64_t countWheelPrimes(std::uint64_t limit)
+    {
+        return (limit > 2) + (limit > 3) + (limit > 5);
+    }
+
+    unsigned usefulThreads(std::uint64_t totalBytes, unsigned threadCount)
+    {
+        std::uint64_t most{ std::max<std::uint64_t>(1, totalBytes / minBytesPerThread) };
+        return static_cast<unsigned>(std::clamp<std::uint64_t>(threadCount, 1, most));
+    }
+
+    // Splits [0, totalBytes) into threadCount segment-aligned ranges and runs
+    // work(threadIndex, firstByte, endByte) for each on its own thread
+    template <typename Work>
+    void forEachThreadRange(std::uint64_t totalBytes, unsigned threadCount, Work work)
+    {
+        std::uint64_t segments{ (totalBytes + segmentBytes - 1) / segmentBytes };
+        std::uint64_t segmentsPerThread{ (segments + threadCount - 1) / threadCount };
+
+        std::vector<std::thread> threads{};
+        for (unsigned t{ 0 }; t < threadCount; ++t)
+        {
+            std::uint64_t first{ std::min(totalBytes, t * segmentsPerThread * segmentBytes) };
+            std::uint64_t end{ std::min(totalBytes, first + segmentsPerThread * segmentBytes) };
+            if (first < end)
+                threads.emplace_back(work, t, first, end);
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+    {
+        return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+    }
+
+    std::uint64_t powMod(std::uint64_t base, std::uint64_t exponent, std::uint64_t m)
+    {
+        std::uint64_t result{ 1 };
+        base %= m;
+        while (exponent > 0)
+        {
+            if (exponent & 1)
+                result = mulMod(result, base, m);
+            base = mulMod(base, base, m);
+            exponent >>= 1;
+        }
+        return result;
+    }
+}
+
+bool isPrimeMillerRabin(std::uint64_t n)
+{
+    // The first twelve primes as bases make the test exact for every n < 3.3 * 10^24
+    constexpr std::array<std::uint64_t, 12> bases{ 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+    if (n < 2)
+        return false;
+
+    for (std::uint64_t p : bases)
+    {
+        if (n % p == 0)
+            return n == p;
+    }
+
+    // n - 1 = d * 2^s with d odd
+    std::uint64_t d{ n - 1 };
+    int s{ 0 };
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        ++s;
+    }
+
+    for (std::uint64_t a : bases)
+    {
+        std::uint64_t x{ powMod(a, d, n) };
+        if (x == 1 || x == n - 1)
+            continue;
+
+        bool witness{ true };
+        for (int r{ 1 }; r < s; ++r)
+        {
+            x = mulMod(x, x, n);
+            if (x == n - 1)
+            {
+                witness = false;
+                break;
+            }
+        }
+
+        if (witness)
+            return false;
+    }
+
+    return true;
+}
+
+bool isPrime(std::uint64_t n)
+{
+    static const PrimeSieve s_small{ std::uint64_t{ 1 } << 20, 1 };
+    return s_small.isPrime(n);
+}
+
+std::uint64_t countPrimes(std::uint64_t limit, unsigned threadCount)
+{
+    if (limit < 2)
+        return 0;
+
+    std::uint64_t totalBytes{ (limit + 29) / 30 };
+    std::vector<std::uint32_t> primes{ sievingPrimes(integerSqrt(limit - 1)) };
+
+    threadCount = usefulThreads(totalBytes, threadCount);
+    std::vector<std::uint64_t> counts(threadCount);
+
+    // Each thread sieves its range one segment at a time into a private buffer and
+    // counts as it goes, so nothing proportional to limit is ever stored
+    forEachThreadRange(totalBytes, threadCount, [&](unsigned t, std::uint64_t first, std::uint64_t end) {
+        std::vector<std::uint8_t> buffer(segmentBytes);
+        std::uint64_t count{ 0 };
+
+        sieveSegments(first, end, primes,
+            [&buffer](std::uint64_t) { return buffer.data(); },
+            [&count, totalBytes, limit](std::uint8_t* bits, std::uint64_t segment, std::uint64_t length) {
+                if (segment + length == totalBytes)
+                    bits[length - 1] &= bitsBelow(totalBytes - 1, limit);
+                for (std::uint64_t i{ 0 }; i < length; ++i)
+                    count += static_cast<std::uint64_t>(__builtin_popcount(bits[i]));
+            });
+
+        counts[t] = count;
+    });
+
+    std::uint64_t total{ countWheelPrimes(limit) };
+    for (std::uint64_t count : counts)
+        total += count;
+
+    return total;
+}
+
+PrimeSieve::PrimeSieve(std::uint64_t limit, unsigned threadCount)
+    : m_limit{ limit }, m_bits((limit + 29) / 30)
+{
+    if (m_bits.empty())
+        return;
+
+    std::uint64_t totalBytes{ m_bits.size() };
+    std::vector<std::uint32_t> primes{ sievingPrimes(integerSqrt(limit - 1)) };
+
+    // Every thread sieves its own slice of m_bits in place
+    forEachThreadRange(totalBytes, usefulThreads(totalBytes, threadCount), [this, &primes](unsigned, std::uint64_t first, std::uint64_t end) {
+        sieveSegments(first, end, primes,
+            [this](std::uint64_t segment) { return m_bits.data() + segment; },
+            [](std::uint8_t*, std::uint64_t, std::uint64_t) {});
+    });
+
+    m_bits.back() &= bitsBelow(totalBytes - 1, limit);
+}
+
+bool PrimeSieve::isPrime(std::uint64_t n) const
+{
+    if (n >= m_limit)
+        return isPrimeMillerRabin(n);
+
+    if (n < 7)
+        return n == 2 || n == 3 || n == 5;
+
+    int bit{ residueBit[n % 30] };
+    return bit >= 0 && (m_bits[n / 30] >> bit) & 1;
+}
+
+std::uint64_t PrimeSieve::count() const
+{
+    std::uint64_t total{ countWheelPrimes(m_limit) };
+    for (std::uint8_t byte : m_bits)
+        total += static_cast<std::uint64_t>(__builtin_popcount(byte));
+    return total;
+}
+
+std::vector<std::uint64_t> PrimeSieve::primes() const
+{
+    std::vector<std::uint64_t> result{};
+    for (std::uint64_t p : { 2, 3, 5 })
+    {
+        if (p < m_limit)
+            result.push_back(p);
+    }
+
+    for (std::uint64_t byte{ 0 }; byte < m_bits.size(); ++byte)
+    {
+        for (std::size_t bit{ 0 }; bit < wheelResidues.size(); ++bit)
+        {
+            if ((m_bits[byte] >> bit) & 1)
+                result.push_back(byte * 30 + wheelResidues[bit]);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,49 @@
+// Header file for the prime number functions and the PrimeSieve class
+//
+// isPrime() answers single queries: small numbers are looked up in a sieve built
+// once on first use, larger ones go to a deterministic Miller-Rabin test that is
+// exact for every 64-bit input. countPrimes() and PrimeSieve run a segmented Sieve
+// of Eratosthenes split across threads.
+
+#ifndef PRIMES_H
+#define PRIMES_H
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Deterministic Miller-Rabin: exact (no false positives) for all 64-bit n
+bool isPrimeMillerRabin(std::uint64_t n);
+
+// Sieve lookup for n below 2^20, Miller-Rabin above
+bool isPrime(std::uint64_t n);
+
+// Number of primes below limit, e.g. countPrimes(100) is 25.
+// Memory use stays at one cache-sized segment per thread however large limit is.
+std::uint64_t countPrimes(std::uint64_t limit, unsigned threadCount = std::thread::hardware_concurrency());
+
+// Stores which numbers below limit are prime, one bit per number coprime to 30
+// (a "wheel-30" layout: each byte covers 30 consecutive numbers using 8 bits, since
+// only the residues 1, 7, 11, 13, 17, 19, 23 and 29 mod 30 can be prime past 5)
+class PrimeSieve
+{
+private:
+    std::uint64_t m_limit{};
+    std::vector<std::uint8_t> m_bits{};
+
+public:
+    explicit PrimeSieve(std::uint64_t limit, unsigned threadCount = std::thread::hardware_concurrency());
+
+    std::uint64_t limit() const { return m_limit; }
+
+    // O(1) bit lookup below limit(); falls back to Miller-Rabin at or above it
+    bool isPrime(std::uint64_t n) const;
+
+    // Number of primes below limit()
+    std::uint64_t count() const;
+
+    // Every prime below limit(), in increasing order
+    std::vector<std::uint64_t> primes() const;
+};
+
+#endif
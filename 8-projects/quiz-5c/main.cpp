@@ -1,3 +1,5 @@
+#include "vec.h"
+
 #include <iostream>
 
 template <typename T, typename U>
@@ -12,5 +14,16 @@ int main()
 	std::cout << sub(3.5, 2) << '\n';
 	std::cout << sub(4, 1.5) << '\n';
 
+    // The same promotion, applied elementwise and evaluated in a single loop
+    Vec<int> a{ 1, 2, 3, 4 };
+    Vec<int> b{ 5, 6, 7, 8 };
+    Vec<double> c{ 0.5, 1.5, 2.5, 3.5 };
+
+    Vec<int> sum{ a + b };
+    auto d{ eval(a + b * c - 1) }; // Vec<double>
+    std::cout << sum << '\n';
+    std::cout << d << '\n';
+    std::cout << eval(4 - c) << '\n';
+
     return 0;
-}
\ No newline at end of file
+}
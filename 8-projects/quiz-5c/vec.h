@@ -0,0 +1,242 @@
+// Header file that defines the Vec<T> class template and its expression templates
+//
+// Arithmetic on Vecs doesn't compute anything straight away: a + b * c - d builds a
+// small expression object that remembers the operands, and the work happens when it
+// is assigned to a Vec, in one loop with no temporary arrays. Mixing element types
+// promotes the same way sub(T, U) does, e.g. Vec<int> - Vec<double> gives doubles.
+
+#ifndef VEC_H
+#define VEC_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept> // for std::invalid_argument
+#include <type_traits>
+#include <utility>   // for std::declval()
+#include <vector>
+
+// Base class for everything that can appear in a Vec expression (CRTP: E is the
+// derived type, so operator[] resolves at compile time and inlines into the loop)
+template <typename E>
+class VecExpr
+{
+public:
+    const E& self() const { return static_cast<const E&>(*this); }
+    std::size_t size() const { return self().size(); }
+    auto operator[](std::size_t i) const { return self()[i]; }
+};
+
+template <typename T>
+class Vec;
+
+namespace vec_detail
+{
+    template <typename T>
+    struct IsVec : std::false_type {};
+    template <typename T>
+    struct IsVec<Vec<T>> : std::true_type {};
+
+    // Vecs are held by reference (they outlive the expression and copying them is
+    // what we're trying to avoid); nested expressions are tiny and held by value, so
+    // auto e{ a + b * c }; doesn't keep a reference to the destroyed b * c temporary
+    template <typename E>
+    using Operand = std::conditional_t<IsVec<E>::value, const E&, const E>;
+
+    // A scalar broadcast to every index, so 2.0 * v is an ordinary binary expression
+    template <typename T>
+    class Scalar : public VecExpr<Scalar<T>>
+    {
+    private:
+        T m_value;
+        std::size_t m_size;
+
+    public:
+        Scalar(T value, std::size_t size) : m_value{ value }, m_size{ size } {}
+        std::size_t size() const { return m_size; }
+        T operator[](std::size_t) const { return m_value; }
+    };
+
+    struct Add      { template <typename A, typename B> auto operator()(A a, B b) const { return a + b; } };
+    struct Subtract { template <typename A, typename B> auto operator()(A a, B b) const { return a - b; } };
+    struct Multiply { template <typename A, typename B> auto operator()(A a, B b) const { return a * b; } };
+    struct Divide   { template <typename A, typename B> auto operator()(A a, B b) const { return a / b; } };
+    struct Negate   { template <typename A> auto operator()(A a) const { return -a; } };
+
+    template <typename L, typename R, typename Op>
+    class Binary : public VecExpr<Binary<L, R, Op>>
+    {
+    private:
+        Operand<L> m_left;
+        Operand<R> m_right;
+
+    public:
+        Binary(const L& left, const R& right) : m_left{ left }, m_right{ right }
+        {
+            if (left.size() != right.size())
+                throw std::invalid_argument{ "Vec sizes don't match" };
+        }
+
+        std::size_t size() const { return m_left.size(); }
+        auto operator[](std::size_t i) const { return Op{}(m_left[i], m_right[i]); }
+    };
+
+    template <typename E, typename Op>
+    class Unary : public VecExpr<Unary<E, Op>>
+    {
+    private:
+        Operand<E> m_operand;
+
+    public:
+        explicit Unary(const E& operand) : m_operand{ operand } {}
+        std::size_t size() const { return m_operand.size(); }
+        auto operator[](std::size_t i) const { return Op{}(m_operand[i]); }
+    };
+
+    // Element type an expression produces
+    template <typename E>
+    using ValueType = std::decay_t<decltype(std::declval<const E&>()[0])>;
+
+    template <typename L, typename R, typename Op>
+    auto makeBinary(const VecExpr<L>& left, const VecExpr<R>& right)
+    {
+        return Binary<L, R, Op>{ left.self(), right.self() };
+    }
+
+    template <typename L, typename S, typename Op, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    auto makeBinary(const VecExpr<L>& left, S right)
+    {
+        return Binary<L, Scalar<S>, Op>{ left.self(), Scalar<S>{ right, left.size() } };
+    }
+
+    template <typename S, typename R, typename Op, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+    auto makeBinary(S left, const VecExpr<R>& right)
+    {
+        return Binary<Scalar<S>, R, Op>{ Scalar<S>{ left, right.size() }, right.self() };
+    }
+}
+
+template <typename T>
+class Vec : public VecExpr<Vec<T>>
+{
+private:
+    std::vector<T> m_data{};
+
+    // The single loop every expression ends up in
+    template <typename E, typename Apply>
+    void evaluate(const VecExpr<E>& expr, Apply apply)
+    {
+        const E& e{ expr.self() };
+        if (e.size() != m_data.size())
+            throw std::invalid_argument{ "Vec sizes don't match" };
+
+        T* data{ m_data.data() };
+        std::size_t n{ m_data.size() };
+        for (std::size_t i{ 0 }; i < n; ++i)
+            apply(data[i], e[i]);
+    }
+
+public:
+    using value_type = T;
+
+    Vec() = default;
+    explicit Vec(std::size_t size, T value = T{}) : m_data(size, value) {}
+    Vec(std::initializer_list<T> list) : m_data(list) {}
+
+    // Evaluates an expression in one pass
+    template <typename E>
+    Vec(const VecExpr<E>& expr) : m_data(expr.size())
+    {
+        evaluate(expr, [](T& out, auto value) { out = static_cast<T>(value); });
+    }
+
+    // Evaluates straight into the existing storage (elementwise, so a = a + b is safe)
+    template <typename E>
+    Vec& operator=(const VecExpr<E>& expr)
+    {
+        if (expr.size() != m_data.size())
+            m_data.resize(expr.size());
+        evaluate(expr, [](T& out, auto value) { out = static_cast<T>(value); });
+        return *this;
+    }
+
+    template <typename E>
+    Vec& operator+=(const VecExpr<E>& expr) { evaluate(expr, [](T& out, auto value) { out += value; }); return *this; }
+    template <typename E>
+    Vec& operator-=(const VecExpr<E>& expr) { evaluate(expr, [](T& out, auto value) { out -= value; }); return *this; }
+    template <typename E>
+    Vec& operator*=(const VecExpr<E>& expr) { evaluate(expr, [](T& out, auto value) { out *= value; }); return *this; }
+    template <typename E>
+    Vec& operator/=(const VecExpr<E>& expr) { evaluate(expr, [](T& out, auto value) { out /= value; }); return *this; }
+
+    Vec& operator*=(T scalar)
+    {
+        for (T& value : m_data)
+            value *= scalar;
+        return *this;
+    }
+
+    std::size_t size() const { return m_data.size(); }
+    const T& operator[](std::size_t i) const { return m_data[i]; }
+    T& operator[](std::size_t i) { return m_data[i]; }
+
+    T* data() { return m_data.data(); }
+    const T* data() const { return m_data.data(); }
+    auto begin() { return m_data.begin(); }
+    auto end() { return m_data.end(); }
+    auto begin() const { return m_data.begin(); }
+    auto end() const { return m_data.end(); }
+
+    friend std::ostream& operator<<(std::ostream& out, const Vec& v)
+    {
+        out << '{';
+        for (std::size_t i{ 0 }; i < v.size(); ++i)
+            out << (i == 0 ? " " : ", ") << v[i];
+        out << " }";
+        return out;
+    }
+};
+
+// Evaluates into a Vec of the expression's own element type, e.g. auto d{ eval(a + c) };
+template <typename E>
+auto eval(const VecExpr<E>& expr)
+{
+    return Vec<vec_detail::ValueType<E>>{ expr };
+}
+
+// Expression operators: any mix of Vec/expression and arithmetic scalar operands
+template <typename L, typename R>
+auto operator+(const L& left, const R& right)
+    -> decltype(vec_detail::makeBinary<L, R, vec_detail::Add>(left, right))
+{
+    return vec_detail::makeBinary<L, R, vec_detail::Add>(left, right);
+}
+
+template <typename L, typename R>
+auto operator-(const L& left, const R& right)
+    -> decltype(vec_detail::makeBinary<L, R, vec_detail::Subtract>(left, right))
+{
+    return vec_detail::makeBinary<L, R, vec_detail::Subtract>(left, right);
+}
+
+template <typename L, typename R>
+auto operator*(const L& left, const R& right)
+    -> decltype(vec_detail::makeBinary<L, R, vec_detail::Multiply>(left, right))
+{
+    return vec_detail::makeBinary<L, R, vec_detail::Multiply>(left, right);
+}
+
+template <typename L, typename R>
+auto operator/(const L& left, const R& right)
+    -> decltype(vec_detail::makeBinary<L, R, vec_detail::Divide>(left, right))
+{
+    return vec_detail::makeBinary<L, R, vec_detail::Divide>(left, right);
+}
+
+template <typename E>
+auto operator-(const VecExpr<E>& operand)
+{
+    return vec_detail::Unary<E, vec_detail::Negate>{ operand.self() };
+}
+
+#endif
@@ -0,0 +1,73 @@
+// Benchmark of sortStrings() against std::sort
+//
+// Build: g++ -std=c++17 -O2 -pthread benchmark.cpp stringsort.cpp -o benchmark
+// Run:   ./benchmark [number of names]
+//
+// Every sort gets its own copy of the same random names, made up of syllables so
+// that, like real names, they share prefixes and vary in length.
+
+#include "stringsort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib> // for std::strtoull()
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> makeNames(std::size_t count)
+    {
+        static constexpr const char* syllables[]{ "an", "be", "car", "da", "el", "fi", "gor", "ha", "is", "jo",
+                                                  "ka", "li", "mar", "na", "o", "pe", "ri", "sa", "ton", "vi" };
+        std::mt19937_64 random{ 2024 };
+        std::vector<std::string> names(count);
+        for (std::string& name : names)
+        {
+            for (int part{ 0 }; part < 2; ++part)
+            {
+                std::size_t length{ 2 + random() % 3 };
+                for (std::size_t s{ 0 }; s < length; ++s)
+                    name += syllables[random() % std::size(syllables)];
+                if (part == 0)
+                    name += ' ';
+            }
+            name[0] = static_cast<char>(name[0] - 'a' + 'A');
+        }
+        return names;
+    }
+
+    template <typename Sort>
+    double secondsFor(std::vector<std::string> names, const std::vector<std::string>& expected, Sort sort)
+    {
+        auto start{ std::chrono::steady_clock::now() };
+        sort(names);
+        double seconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+        if (names != expected)
+            std::cout << "  (wrong order!)";
+        return seconds;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000 };
+    unsigned threads{ std::max(1u, std::thread::hardware_concurrency()) };
+
+    std::vector<std::string> names{ makeNames(count) };
+    std::vector<std::string> expected{ names };
+    std::sort(expected.begin(), expected.end());
+
+    std::cout << "Sorting " << count << " names\n";
+    std::cout << "std::sort:                  "
+              << secondsFor(names, expected, [](auto& v) { std::sort(v.begin(), v.end()); }) << " s\n";
+    std::cout << "sortStrings, 1 thread:      "
+              << secondsFor(names, expected, [](auto& v) { sortStrings(v, 1); }) << " s\n";
+    std::cout << "sortStrings, " << threads << " threads:    "
+              << secondsFor(names, expected, [&](auto& v) { sortStrings(v, threads); }) << " s\n";
+
+    return 0;
+}
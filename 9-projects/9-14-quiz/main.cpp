@@ -1,7 +1,7 @@
 #include <iostream>
 #include <string>
-#include <algorithm>
 #include <limits>
+#include "stringsort.h"
 
 void printArray(std::string* arrayptr, std::size_t len)
 {
@@ -40,8 +40,8 @@ int main()
     // get the names
     getNames(strarray, number_names);
 
-    // sort the names
-    std::sort(strarray, strarray + number_names);
+    // sort the names (same order as std::sort, but quicker on long lists)
+    sortStrings(strarray, number_names);
 
     // print the sorted list of names
     printArray(strarray, number_names);
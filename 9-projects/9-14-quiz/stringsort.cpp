@@ -0,0 +1,255 @@
+// sortStrings() defined here
+//
+// Entries are sorted in place and only point at their strings by index. At the end
+// the strings are moved into the sorted order in two parallel passes through a
+// scratch array. Moving a std::string only copies its 32-byte header, never the
+// characters.
+
+#include "stringsort.h"
+
+#include <algorithm> // for std::sort(), std::partition()
+#include <atomic>
+#include <cstdint>
+#include <cstring> // for std::memcpy()
+#include <string_view>
+#include <thread>
+#include <utility> // for std::swap(), std::move()
+
+namespace
+{
+    struct Entry
+    {
+        std::uint64_t key; // the 8 characters at the current depth, first one in the top byte
+        std::size_t index; // where the string is in the caller's array
+    };
+
+    constexpr std::size_t keyBytes{ 8 };
+
+    // The radix pass buckets by the first two characters: the top 16 bits of the key
+    constexpr int bucketBits{ 16 };
+    constexpr std::size_t bucketCount{ std::size_t{ 1 } << bucketBits };
+
+    // Below this the radix pass and the threads cost more than they save
+    constexpr std::size_t radixThreshold{ 1 << 14 };
+
+    constexpr std::ptrdiff_t insertionSortSize{ 16 };
+
+    // Packs the characters at s[depth..depth + 8) into an integer that compares like
+    // them, padding with zeros past the end of the string
+    std::uint64_t keyAt(const std::string& s, std::size_t depth)
+    {
+        unsigned char bytes[keyBytes]{};
+        if (depth < s.size())
+            std::memcpy(bytes, s.data() + depth, std::min(keyBytes, s.size() - depth));
+
+        std::uint64_t key{ 0 };
+        for (unsigned char byte : bytes)
+            key = key << 8 | byte;
+        return key;
+    }
+
+    // Calls work(thread) on threadCount threads, one of them the calling thread
+    template <typename Work>
+    void runThreads(unsigned threadCount, Work work)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (unsigned t{ 1 }; t < threadCount; ++t)
+            threads.emplace_back(work, t);
+        work(0u);
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    // Thread t's share of count items
+    std::size_t chunkStart(std::size_t count, unsigned t, unsigned threadCount)
+    {
+        return count * t / threadCount;
+    }
+
+    class Sorter
+    {
+    private:
+        const std::string* m_strings{};
+
+        // Orders two entries whose strings share their first depth characters
+        bool less(const Entry& a, const Entry& b, std::size_t depth) const
+        {
+            if (a.key != b.key)
+                return a.key < b.key;
+            return std::string_view{ m_strings[a.index] }.substr(depth)
+                 < std::string_view{ m_strings[b.index] }.substr(depth);
+        }
+
+        void insertionSort(Entry* first, Entry* last, std::size_t depth) const
+        {
+            for (Entry* i{ first + 1 }; i < last; ++i)
+            {
+                Entry entry{ *i };
+                Entry* j{ i };
+                for (; j > first && less(entry, *(j - 1), depth); --j)
+                    *j = *(j - 1);
+                *j = entry;
+            }
+        }
+
+        static std::uint64_t medianKey(std::uint64_t a, std::uint64_t b, std::uint64_t c)
+        {
+            if (a < b)
+                return b < c ? b : (a < c ? c : a);
+            return a < c ? a : (b < c ? c : b);
+        }
+
+    public:
+        explicit Sorter(const std::string* strings)
+            : m_strings{ strings }
+        {
+        }
+
+        // Multikey quicksort of entries whose strings share their first depth characters
+        // and whose keys hold the 8 after that. budget bounds the partitions on any one
+        // path; if bad pivots use it up, the range falls back to std::sort.
+        void sort(Entry* first, Entry* last, std::size_t depth, int budget) const
+        {
+            while (last - first > insertionSortSize)
+            {
+                if (budget-- == 0)
+                {
+                    std::sort(first, last, [&](const Entry& a, const Entry& b) { return less(a, b, depth); });
+                    return;
+                }
+
+                // Three-way partition on the key: [first, lt) < pivot, [lt, gt) == pivot, [gt, last) > pivot
+                std::uint64_t pivot{ medianKey(first->key, first[(last - first) / 2].key, (last - 1)->key) };
+                Entry* lt{ first };
+                Entry* gt{ last };
+                for (Entry* i{ first }; i < gt;)
+                {
+                    if (i->key < pivot)
+                        std::swap(*lt++, *i++);
+                    else if (i->key > pivot)
+                        std::swap(*i, *--gt);
+                    else
+                        ++i;
+                }
+                sort(first, lt, depth, budget);
+                sort(gt, last, depth, budget);
+
+                // The equal keys: strings that end within these 8 characters are only
+                // told apart by their length (the key pads them with zeros), and they
+                // come before the strings that go on
+                Entry* goOn{ std::partition(lt, gt, [&](const Entry& e) {
+                    return m_strings[e.index].size() <= depth + keyBytes;
+                }) };
+                std::sort(lt, goOn, [&](const Entry& a, const Entry& b) {
+                    return m_strings[a.index].size() < m_strings[b.index].size();
+                });
+
+                // The rest move on to their next 8 characters
+                first = goOn;
+                last = gt;
+                depth += keyBytes;
+                for (Entry* e{ first }; e < last; ++e)
+                    e->key = keyAt(m_strings[e->index], depth);
+            }
+            insertionSort(first, last, depth);
+        }
+
+        static int budgetFor(std::size_t count)
+        {
+            int log2{ 0 };
+            for (; count > 1; count /= 2)
+                ++log2;
+            return 2 * log2 + 16;
+        }
+    };
+}
+
+void sortStrings(std::string* strings, std::size_t count, unsigned threadCount)
+{
+    if (count < 2)
+        return;
+
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (count < radixThreshold)
+        threadCount = 1;
+
+    Sorter sorter{ strings };
+    std::vector<Entry> entries(count);
+
+    if (count < radixThreshold)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            entries[i] = { keyAt(strings[i], 0), i };
+        sorter.sort(entries.data(), entries.data() + count, 0, Sorter::budgetFor(count));
+    }
+    else
+    {
+        // Radix pass: each thread counts the buckets of its share of the strings...
+        std::vector<Entry> unsorted(count);
+        std::vector<std::vector<std::size_t>> offsets(threadCount, std::vector<std::size_t>(bucketCount));
+        runThreads(threadCount, [&](unsigned t) {
+            std::vector<std::size_t>& counts{ offsets[t] };
+            for (std::size_t i{ chunkStart(count, t, threadCount) }; i < chunkStart(count, t + 1, threadCount); ++i)
+            {
+                unsorted[i] = { keyAt(strings[i], 0), i };
+                ++counts[unsorted[i].key >> (64 - bucketBits)];
+            }
+        });
+
+        // ...which become where each thread writes into each bucket
+        std::vector<std::size_t> bucketStart(bucketCount + 1);
+        std::size_t position{ 0 };
+        for (std::size_t b{ 0 }; b < bucketCount; ++b)
+        {
+            bucketStart[b] = position;
+            for (unsigned t{ 0 }; t < threadCount; ++t)
+            {
+                std::size_t counted{ offsets[t][b] };
+                offsets[t][b] = position;
+                position += counted;
+            }
+        }
+        bucketStart[bucketCount] = count;
+
+        runThreads(threadCount, [&](unsigned t) {
+            std::vector<std::size_t>& next{ offsets[t] };
+            for (std::size_t i{ chunkStart(count, t, threadCount) }; i < chunkStart(count, t + 1, threadCount); ++i)
+                entries[next[unsorted[i].key >> (64 - bucketBits)]++] = unsorted[i];
+        });
+
+        // Then the threads take the buckets, largest first so none is left holding a
+        // big one at the end
+        std::vector<std::size_t> work;
+        for (std::size_t b{ 0 }; b < bucketCount; ++b)
+        {
+            if (bucketStart[b + 1] - bucketStart[b] > 1)
+                work.push_back(b);
+        }
+        std::sort(work.begin(), work.end(), [&](std::size_t a, std::size_t b) {
+            return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+
+        std::atomic<std::size_t> nextWork{ 0 };
+        runThreads(threadCount, [&](unsigned) {
+            for (std::size_t w{ nextWork++ }; w < work.size(); w = nextWork++)
+            {
+                Entry* first{ entries.data() + bucketStart[work[w]] };
+                Entry* last{ entries.data() + bucketStart[work[w] + 1] };
+                sorter.sort(first, last, 0, Sorter::budgetFor(static_cast<std::size_t>(last - first)));
+            }
+        });
+    }
+
+    // Move the strings into order through a scratch array
+    std::vector<std::string> scratch(count);
+    runThreads(threadCount, [&](unsigned t) {
+        for (std::size_t i{ chunkStart(count, t, threadCount) }; i < chunkStart(count, t + 1, threadCount); ++i)
+            scratch[i] = std::move(strings[entries[i].index]);
+    });
+    runThreads(threadCount, [&](unsigned t) {
+        for (std::size_t i{ chunkStart(count, t, threadCount) }; i < chunkStart(count, t + 1, threadCount); ++i)
+            strings[i] = std::move(scratch[i]);
+    });
+}
@@ -0,0 +1,34 @@
+// Header file that declares sortStrings()
+//
+// Sorts large arrays of std::string faster than std::sort. With std::sort every
+// comparison follows two pointers to the characters, and for tens of millions of
+// names nearly all of those reads are cache misses.
+//
+// sortStrings() sorts small entries instead: each holds the next 8 characters of its
+// string packed into one integer (the "cached prefix key") and the string's index.
+// Most comparisons are then a single integer compare. The characters are only read
+// again when 8 characters tie and the next 8 are needed.
+//
+// The work is split across threads in two steps. First an MSD radix pass sorts the
+// entries into 65536 buckets by their first two characters. Then the threads take
+// buckets, largest first, and finish each one with multikey quicksort, which
+// partitions on the cached key and moves on to the next 8 characters for the
+// entries that tie.
+
+#ifndef STRINGSORT_H
+#define STRINGSORT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Sorts strings[0..count) into the same order as std::sort. Uses threadCount
+// threads, or one per hardware thread if threadCount is 0.
+void sortStrings(std::string* strings, std::size_t count, unsigned threadCount = 0);
+
+inline void sortStrings(std::vector<std::string>& strings, unsigned threadCount = 0)
+{
+    sortStrings(strings.data(), strings.size(), threadCount);
+}
+
+#endif
@@ -1,6 +1,6 @@
 #include <iostream>
 #include <array>
-#include <algorithm>
+#include "../quiz-2/keysort.h"
 
 void printArray(const std::array<double, 5> &arr)
 {
@@ -20,7 +20,8 @@ int main()
 {
     std::array<double, 5> myArray{ 1.0, 5.7, 9.0, 2.0, 0.1 };
 
-    std::sort(myArray.begin(), myArray.end());
+    // same order as std::sort (a NaN would go last)
+    sortByKey(myArray, [](double element) { return element; });
 
     printArray(myArray);
 
@@ -0,0 +1,177 @@
+// Benchmark matrix for sorting.h: every sort against std::sort
+//
+// Build: g++ -std=c++17 -O2 -pthread benchmark.cpp -o benchmark
+// Run:   ./benchmark [largest size]    (default 10^7; 10^8 needs about 2.5 GB)
+//
+// Sizes are 8, 16 and then powers of 10 from 100, each sorted in four shapes: already
+// sorted, reversed, random, and random from only 16 different values. Times are in
+// nanoseconds per element. Small sizes are sorted many times over (each time a fresh
+// copy) so the clock has something to measure. The O(n^2) sorts stop at 10^4 and the
+// sorting network only takes up to 16 elements; "-" marks where a sort was skipped.
+
+#include "sorting.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath> // for std::signbit()
+#include <cstdlib> // for std::strtoull()
+#include <iomanip>
+#include <iostream>
+#include <iterator> // for std::size()
+#include <limits>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    enum class Shape
+    {
+        sorted,
+        reversed,
+        random,
+        fewUnique,
+    };
+
+    constexpr Shape shapes[]{ Shape::sorted, Shape::reversed, Shape::random, Shape::fewUnique };
+    constexpr std::string_view shapeNames[]{ "sorted", "reversed", "random", "few unique" };
+
+    std::vector<int> makeInput(Shape shape, std::size_t size, std::mt19937& random)
+    {
+        std::vector<int> values(size);
+        for (std::size_t i{ 0 }; i < size; ++i)
+        {
+            switch (shape)
+            {
+            case Shape::sorted:    values[i] = static_cast<int>(i); break;
+            case Shape::reversed:  values[i] = static_cast<int>(size - i); break;
+            case Shape::random:    values[i] = static_cast<int>(random()); break;
+            case Shape::fewUnique: values[i] = static_cast<int>(random() % 16); break;
+            }
+        }
+        return values;
+    }
+
+    // Sorts repeats copies of input one after another; returns ns per element, or a
+    // negative number if any copy came out unsorted
+    template <typename Sort>
+    double nanosecondsFor(const std::vector<int>& input, std::size_t repeats, Sort sort)
+    {
+        std::size_t size{ input.size() };
+        std::vector<int> copies(size * repeats);
+        for (std::size_t r{ 0 }; r < repeats; ++r)
+            std::copy(input.begin(), input.end(), copies.begin() + r * size);
+
+        auto start{ std::chrono::steady_clock::now() };
+        for (std::size_t r{ 0 }; r < repeats; ++r)
+            sort(copies.data() + r * size, copies.data() + (r + 1) * size);
+        double seconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+        for (std::size_t r{ 0 }; r < repeats; ++r)
+        {
+            if (!std::is_sorted(copies.begin() + r * size, copies.begin() + (r + 1) * size))
+                return -1.0;
+        }
+        return seconds * 1e9 / static_cast<double>(size * repeats);
+    }
+
+    // networkSort() pads short inputs to the network's size, so check that the padding
+    // can't take the place of an infinity (or -0.0 of +0.0) in the data
+    // (float takes the SSE2 network from 9 values up, double the scalar one)
+    template <typename T>
+    bool networkSortKeepsInfinities()
+    {
+        constexpr T infinity{ std::numeric_limits<T>::infinity() };
+        constexpr T tricky[]{ infinity, 1.0, -2.0, 3.0, 0.5, -infinity, -0.0, 0.0,
+                              infinity, 7.0, -0.0, 2.5, -infinity, 0.0, 4.0, infinity };
+        for (std::size_t count{ 1 }; count <= std::size(tricky); ++count)
+        {
+            T values[std::size(tricky)];
+            T expected[std::size(tricky)];
+            std::copy_n(tricky, count, values);
+            std::copy_n(tricky, count, expected);
+            sorting::networkSort(values, count);
+            std::sort(expected, expected + count);
+            for (std::size_t i{ 0 }; i < count; ++i)
+            {
+                if (values[i] != expected[i])
+                    return false;
+            }
+
+            int negativeZeros{ 0 };
+            for (std::size_t i{ 0 }; i < count; ++i)
+                negativeZeros += (tricky[i] == 0.0 && std::signbit(tricky[i])) - (values[i] == 0.0 && std::signbit(values[i]));
+            if (negativeZeros != 0)
+                return false;
+        }
+        return true;
+    }
+
+    struct Algorithm
+    {
+        std::string_view name;
+        std::size_t largestSize;
+        void (*sort)(int* first, int* last);
+    };
+
+    unsigned threadCount{ 1 };
+
+    const Algorithm algorithms[]{
+        { "std::sort", ~std::size_t{ 0 }, [](int* first, int* last) { std::sort(first, last); } },
+        { "selectionSort", 10'000, [](int* first, int* last) { sorting::selectionSort(first, last); } },
+        { "bubbleSort", 10'000, [](int* first, int* last) { sorting::bubbleSort(first, last); } },
+        { "insertionSort", 10'000, [](int* first, int* last) { sorting::insertionSort(first, last); } },
+        { "networkSort", 16, [](int* first, int* last) { sorting::networkSort(first, static_cast<std::size_t>(last - first)); } },
+        { "pdqSort", ~std::size_t{ 0 }, [](int* first, int* last) { sorting::pdqSort(first, last); } },
+        { "parallelMergeSort", ~std::size_t{ 0 },
+          [](int* first, int* last) { sorting::parallelMergeSort(first, last, std::less<>{}, threadCount); } },
+        { "radixSort", ~std::size_t{ 0 }, [](int* first, int* last) { sorting::radixSort(first, last); } },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t largest{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000 };
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::mt19937 random{ 2024 };
+
+    std::cout << "networkSort with infinities and signed zeros: "
+              << (networkSortKeepsInfinities<float>() && networkSortKeepsInfinities<double>() ? "ok" : "wrong!") << '\n';
+    std::cout << "ns per element, parallelMergeSort on " << threadCount << " threads\n";
+    for (std::size_t size{ 8 }; size <= largest; size = size == 8 ? 16 : size == 16 ? 100 : size * 10)
+    {
+        // Enough copies to sort about a million elements in all, but at least one
+        std::size_t repeats{ std::max<std::size_t>(1, 1'000'000 / size) };
+
+        std::cout << "\nn = " << size << '\n' << std::setw(20) << "";
+        for (std::string_view name : shapeNames)
+            std::cout << std::setw(12) << name;
+        std::cout << '\n';
+
+        std::vector<std::vector<int>> inputs;
+        for (Shape shape : shapes)
+            inputs.push_back(makeInput(shape, size, random));
+
+        for (const Algorithm& algorithm : algorithms)
+        {
+            std::cout << std::setw(20) << std::left << algorithm.name << std::right << std::fixed << std::setprecision(2);
+            for (const std::vector<int>& input : inputs)
+            {
+                if (size > algorithm.largestSize)
+                {
+                    std::cout << std::setw(12) << "-";
+                    continue;
+                }
+                double nanoseconds{ nanosecondsFor(input, repeats, algorithm.sort) };
+                if (nanoseconds < 0)
+                    std::cout << std::setw(12) << "wrong!";
+                else
+                    std::cout << std::setw(12) << nanoseconds;
+            }
+            std::cout << '\n';
+        }
+    }
+
+    return 0;
+}
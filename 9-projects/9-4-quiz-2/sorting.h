@@ -0,0 +1,959 @@
+// Header file for the sorting library
+//
+// The hand-written sorts from the 9.4 quizzes plus the faster algorithms we use on
+// big inputs. All of them take a range and (except the last two) a comparison, like
+// std::sort. benchmark.cpp times every one of them on sizes from 8 to 10^8 and on
+// sorted, reversed, random and few-unique inputs, to show which one suits which call.
+//
+//   selectionSort      O(n^2) compares, but at most n - 1 swaps
+//   bubbleSort         O(n^2), stops early once a pass makes no swap (so O(n) if sorted)
+//   insertionSort      O(n^2), but the quickest of all for a few dozen elements
+//   networkSort        up to 16 numbers with a fixed sorting network: no branches, and
+//                      for 9 to 16 int32_t or float, four compare-exchanges at a time (SSE2)
+//   pdqSort            pattern-defeating quicksort, O(n log n) worst case, and
+//                      linear on sorted, reversed and few-unique inputs
+//   parallelMergeSort  stable, splits the sorting and the merging between threads
+//   radixSort          integers and floating point, O(n) passes over the bytes
+
+#ifndef SORTING_H
+#define SORTING_H
+
+#include <algorithm> // for std::stable_sort(), std::lower_bound(), std::make_heap(), std::sort_heap()
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy()
+#include <functional> // for std::less
+#include <iterator>
+#include <limits>
+#include <memory> // for std::unique_ptr
+#include <thread>
+#include <type_traits>
+#include <utility> // for std::move(), std::swap(), std::index_sequence
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sorting
+{
+    // The 9.4 quiz 2 selection sort. Each pass swaps the element that should come first
+    // into place. (With std::greater it sorts largest first, as the quiz did.)
+    template <typename Iterator, typename Compare = std::less<>>
+    void selectionSort(Iterator first, Iterator last, Compare comp = {})
+    {
+        for (Iterator start{ first }; start != last; ++start)
+        {
+            Iterator smallest{ start };
+            for (Iterator current{ std::next(start) }; current != last; ++current)
+            {
+                if (comp(*current, *smallest))
+                    smallest = current;
+            }
+            std::iter_swap(start, smallest);
+        }
+    }
+
+    // The 9.4 quiz 3 bubble sort. Returns the pass on which it stopped: the first pass
+    // that made no swap (or the last pass, if every one did).
+    template <typename Iterator, typename Compare = std::less<>>
+    int bubbleSort(Iterator first, Iterator last, Compare comp = {})
+    {
+        int pass{ 0 };
+        for (Iterator end{ last }; ; --end)
+        {
+            ++pass;
+            bool swapped{ false };
+            for (Iterator i{ first }; i != end && std::next(i) != end; ++i)
+            {
+                if (comp(*std::next(i), *i))
+                {
+                    std::iter_swap(i, std::next(i));
+                    swapped = true;
+                }
+            }
+            if (!swapped || end == first)
+                return pass;
+        }
+    }
+
+    template <typename Iterator, typename Compare = std::less<>>
+    void insertionSort(Iterator first, Iterator last, Compare comp = {})
+    {
+        if (first == last)
+            return;
+        for (Iterator current{ std::next(first) }; current != last; ++current)
+        {
+            auto value{ std::move(*current) };
+            Iterator hole{ current };
+            for (Iterator previous{ current }; hole != first && comp(value, *--previous); --hole)
+                *hole = std::move(*previous);
+            *hole = std::move(value);
+        }
+    }
+
+    namespace detail
+    {
+        struct Exchange
+        {
+            std::uint8_t a;
+            std::uint8_t b;
+        };
+
+        // Optimal networks (fewest comparators known) for 8 and 16 inputs
+        constexpr Exchange network8[]{
+            { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+            { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+            { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+            { 2, 4 }, { 3, 5 },
+            { 1, 4 }, { 3, 6 },
+            { 1, 2 }, { 3, 4 }, { 5, 6 },
+        };
+
+        constexpr Exchange network16[]{
+            { 0, 13 }, { 1, 12 }, { 2, 15 }, { 3, 14 }, { 4, 8 }, { 5, 6 }, { 7, 11 }, { 9, 10 },
+            { 0, 5 }, { 1, 7 }, { 2, 9 }, { 3, 4 }, { 6, 13 }, { 8, 14 }, { 10, 15 }, { 11, 12 },
+            { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 8 }, { 7, 9 }, { 10, 11 }, { 12, 13 }, { 14, 15 },
+            { 0, 2 }, { 1, 3 }, { 4, 10 }, { 5, 11 }, { 6, 7 }, { 8, 9 }, { 12, 14 }, { 13, 15 },
+            { 1, 2 }, { 3, 12 }, { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 }, { 13, 14 },
+            { 1, 4 }, { 2, 6 }, { 5, 8 }, { 7, 10 }, { 9, 13 }, { 11, 14 },
+            { 2, 4 }, { 3, 6 }, { 9, 12 }, { 11, 13 },
+            { 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 },
+            { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+            { 6, 7 }, { 8, 9 },
+        };
+
+        template <typename T>
+        constexpr T largestValue()
+        {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return std::numeric_limits<T>::infinity();
+            else
+                return std::numeric_limits<T>::max();
+        }
+
+        template <typename T>
+        void compareExchange(T& a, T& b)
+        {
+            // Both selects compile to branch-free cmovs, so the time doesn't depend on
+            // the data and there are no mispredictions. (Not std::min and std::max: for
+            // equal values, like -0.0 and +0.0, both return a and b would be lost.)
+            bool swap{ b < a };
+            T low{ swap ? b : a };
+            T high{ swap ? a : b };
+            a = low;
+            b = high;
+        }
+
+        // The network is a template argument so every exchange is unrolled with fixed
+        // indices, which lets the values stay in registers
+        template <typename T, std::size_t Size, const auto& Network, std::size_t... Indices>
+        void runNetwork(T* data, std::size_t count, std::index_sequence<Indices...>)
+        {
+            // Pad with the largest value, which the network leaves at the end (infinity
+            // for floating point, where max() is less than an infinity in the data)
+            T values[Size];
+            for (std::size_t i{ 0 }; i < Size; ++i)
+                values[i] = i < count ? data[i] : largestValue<T>();
+
+            (compareExchange(values[Network[Indices].a], values[Network[Indices].b]), ...);
+
+            for (std::size_t i{ 0 }; i < count; ++i)
+                data[i] = values[i];
+        }
+    }
+
+#if defined(__SSE2__)
+    namespace detail
+    {
+        // The SSE2 network works on four int32_t lanes per register. float is sorted as
+        // int32_t keys that compare the same way (positive floats already do; negative
+        // ones get every bit but the sign flipped), so -0.0 and +0.0 keep their bits.
+        // Applying the mapping twice gives back the float.
+        inline __m128i floatKeys(__m128i bits)
+        {
+            return _mm_xor_si128(bits, _mm_srli_epi32(_mm_srai_epi32(bits, 31), 1));
+        }
+
+        // compareExchange on four pairs at once, each lane of a with the same lane of b.
+        // Swapping is done as a ^= d, b ^= d with d = (a ^ b) where a > b, which takes
+        // fewer instructions than selecting with and/andnot/or.
+        inline void compareExchangeLanes(__m128i& a, __m128i& b)
+        {
+            __m128i difference{ _mm_and_si128(_mm_xor_si128(a, b), _mm_cmpgt_epi32(a, b)) };
+            a = _mm_xor_si128(a, difference);
+            b = _mm_xor_si128(b, difference);
+        }
+
+        // compareExchange between the lanes of one register: each lane i with lane i ^ 2
+        // (Shuffle 1, 0, 3, 2) or i ^ 1 (Shuffle 2, 3, 0, 1). upperLanes marks the lane
+        // of each pair that should end up with the larger value.
+        template <int Shuffle>
+        __m128i exchangeWithin(__m128i v, __m128i upperLanes)
+        {
+            __m128i other{ _mm_shuffle_epi32(v, Shuffle) };
+            __m128i take{ _mm_xor_si128(_mm_cmpgt_epi32(v, other), upperLanes) };
+            return _mm_xor_si128(v, _mm_and_si128(_mm_xor_si128(v, other), take));
+        }
+
+        // Sorts a register whose lanes go up then down (or down then up)
+        inline __m128i sortBitonic(__m128i v)
+        {
+            v = exchangeWithin<_MM_SHUFFLE(1, 0, 3, 2)>(v, _mm_set_epi32(-1, -1, 0, 0));
+            return exchangeWithin<_MM_SHUFFLE(2, 3, 0, 1)>(v, _mm_set_epi32(-1, 0, -1, 0));
+        }
+
+        // Merges two sorted registers into a sorted run of 8 in a (low) and b (high)
+        inline void mergeRegisters(__m128i& a, __m128i& b)
+        {
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3));
+            compareExchangeLanes(a, b);
+            a = sortBitonic(a);
+            b = sortBitonic(b);
+        }
+
+        // Loads the first count (up to 4) values at data into the lanes of a register,
+        // and fills the rest with the largest int32_t, which the sort leaves at the end.
+        // It never reads past data + count. (Copying short inputs into a padded array
+        // first would be simpler, but loading 16 bytes just written 4 at a time stalls.)
+        template <typename T>
+        __m128i loadLanes(const T* data, std::size_t count)
+        {
+            if (count >= 4)
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+            std::int32_t first[3]{};
+            std::memcpy(first, data, count * sizeof(T));
+            __m128i lanes{ _mm_setr_epi32(first[0], first[1], first[2], 0) };
+            __m128i used{ _mm_cmplt_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(static_cast<int>(count))) };
+            return _mm_or_si128(_mm_and_si128(used, lanes),
+                                _mm_andnot_si128(used, _mm_set1_epi32(std::numeric_limits<std::int32_t>::max())));
+        }
+
+        // Stores the first count (up to 4) lanes of v to data
+        template <typename T>
+        void storeLanes(T* data, __m128i v, std::size_t count)
+        {
+            if (count >= 4)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data), v);
+                return;
+            }
+
+            alignas(16) std::int32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+            std::memcpy(data, lanes, count * sizeof(T));
+        }
+
+        // Sorts up to 16 int32_t or float: sort the four columns of a 4x4 block with a
+        // 4-input network run on whole registers, transpose so each register holds a
+        // sorted column, then merge the columns with bitonic merges
+        template <typename T>
+        void sortSixteenSse2(T* data, std::size_t count)
+        {
+            __m128i r0{ loadLanes(data, count) };
+            __m128i r1{ loadLanes(data + 4, count > 4 ? count - 4 : 0) };
+            __m128i r2{ loadLanes(data + 8, count > 8 ? count - 8 : 0) };
+            __m128i r3{ loadLanes(data + 12, count > 12 ? count - 12 : 0) };
+            if constexpr (std::is_same_v<T, float>)
+            {
+                r0 = floatKeys(r0);
+                r1 = floatKeys(r1);
+                r2 = floatKeys(r2);
+                r3 = floatKeys(r3);
+            }
+
+            compareExchangeLanes(r0, r1);
+            compareExchangeLanes(r2, r3);
+            compareExchangeLanes(r0, r2);
+            compareExchangeLanes(r1, r3);
+            compareExchangeLanes(r1, r2);
+
+            __m128i t0{ _mm_unpacklo_epi32(r0, r1) };
+            __m128i t1{ _mm_unpacklo_epi32(r2, r3) };
+            __m128i t2{ _mm_unpackhi_epi32(r0, r1) };
+            __m128i t3{ _mm_unpackhi_epi32(r2, r3) };
+            r0 = _mm_unpacklo_epi64(t0, t1);
+            r1 = _mm_unpackhi_epi64(t0, t1);
+            r2 = _mm_unpacklo_epi64(t2, t3);
+            r3 = _mm_unpackhi_epi64(t2, t3);
+
+            // Runs of 4 into runs of 8: (r0, r1) and (r2, r3)
+            mergeRegisters(r0, r1);
+            mergeRegisters(r2, r3);
+
+            // Runs of 8 into 16: (r0, r1) against (r2, r3) reversed, which leaves the
+            // low 8 in (r0, r1) and the high 8 in (r3, r2), both bitonic
+            r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(0, 1, 2, 3));
+            r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(0, 1, 2, 3));
+            compareExchangeLanes(r0, r3);
+            compareExchangeLanes(r1, r2);
+            compareExchangeLanes(r0, r1);
+            compareExchangeLanes(r3, r2);
+            r0 = sortBitonic(r0);
+            r1 = sortBitonic(r1);
+            r2 = sortBitonic(r2);
+            r3 = sortBitonic(r3);
+            if constexpr (std::is_same_v<T, float>)
+            {
+                r0 = floatKeys(r0);
+                r1 = floatKeys(r1);
+                r2 = floatKeys(r2);
+                r3 = floatKeys(r3);
+            }
+
+            storeLanes(data, r0, count);
+            storeLanes(data + 4, r1, count > 4 ? count - 4 : 0);
+            storeLanes(data + 8, r3, count > 8 ? count - 8 : 0);
+            storeLanes(data + 12, r2, count > 12 ? count - 12 : 0);
+        }
+    }
+#endif
+
+    // Sorts up to 16 numbers (no NaNs) in ascending order with a sorting network
+    template <typename T>
+    void networkSort(T* data, std::size_t count)
+    {
+        static_assert(std::is_arithmetic_v<T>, "networkSort() sorts numbers");
+
+        if (count <= 1)
+            return;
+#if defined(__SSE2__)
+        // The SSE2 network always sorts 16, so up to 8 the scalar 8-input one is quicker
+        if constexpr (std::is_same_v<T, std::int32_t> || std::is_same_v<T, float>)
+        {
+            if (count > 8 && count <= 16)
+            {
+                detail::sortSixteenSse2(data, count);
+                return;
+            }
+        }
+#endif
+        if (count <= 8)
+            detail::runNetwork<T, 8, detail::network8>(data, count, std::make_index_sequence<std::size(detail::network8)>{});
+        else if (count <= 16)
+            detail::runNetwork<T, 16, detail::network16>(data, count, std::make_index_sequence<std::size(detail::network16)>{});
+        else
+            insertionSort(data, data + count);
+    }
+
+    namespace detail
+    {
+        // pdqSort's tuning, as in Orson Peters' reference implementation
+        constexpr std::ptrdiff_t insertionSortSize{ 24 };
+        constexpr std::ptrdiff_t nintherSize{ 128 };
+        constexpr std::ptrdiff_t partialInsertionLimit{ 8 };
+
+        // Insertion sort that relies on the element before first being no greater
+        // than any in the range, so it needn't check for the start
+        template <typename Iterator, typename Compare>
+        void unguardedInsertionSort(Iterator first, Iterator last, Compare& comp)
+        {
+            if (first == last)
+                return;
+            for (Iterator current{ first + 1 }; current != last; ++current)
+            {
+                if (comp(*current, *(current - 1)))
+                {
+                    auto value{ std::move(*current) };
+                    Iterator hole{ current };
+                    do
+                    {
+                        *hole = std::move(*(hole - 1));
+                        --hole;
+                    } while (comp(value, *(hole - 1)));
+                    *hole = std::move(value);
+                }
+            }
+        }
+
+        // Insertion sort that gives up (returning false) once it has moved more than
+        // partialInsertionLimit elements
+        template <typename Iterator, typename Compare>
+        bool partialInsertionSort(Iterator first, Iterator last, Compare& comp)
+        {
+            if (first == last)
+                return true;
+
+            std::ptrdiff_t moved{ 0 };
+            for (Iterator current{ first + 1 }; current != last; ++current)
+            {
+                if (comp(*current, *(current - 1)))
+                {
+                    auto value{ std::move(*current) };
+                    Iterator hole{ current };
+                    do
+                    {
+                        *hole = std::move(*(hole - 1));
+                        --hole;
+                    } while (hole != first && comp(value, *(hole - 1)));
+                    *hole = std::move(value);
+                    moved += current - hole;
+                }
+                if (moved > partialInsertionLimit)
+                    return false;
+            }
+            return true;
+        }
+
+        template <typename Iterator, typename Compare>
+        void sort2(Iterator a, Iterator b, Compare& comp)
+        {
+            if (comp(*b, *a))
+                std::iter_swap(a, b);
+        }
+
+        template <typename Iterator, typename Compare>
+        void sort3(Iterator a, Iterator b, Iterator c, Compare& comp)
+        {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        // Partitions around the pivot *first: smaller elements to its left, the rest to
+        // its right. Returns where the pivot ended up, and whether nothing had to move.
+        template <typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partitionRight(Iterator begin, Iterator end, Compare& comp)
+        {
+            auto pivot{ std::move(*begin) };
+            Iterator first{ begin };
+            Iterator last{ end };
+
+            // The median-of-3 put an element >= pivot at the end and one <= it at the
+            // start, so these scans stop without bounds checks (except the first one)
+            while (comp(*++first, pivot))
+            {
+            }
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot))
+                {
+                }
+            }
+            else
+            {
+                while (!comp(*--last, pivot))
+                {
+                }
+            }
+
+            bool alreadyPartitioned{ first >= last };
+            while (first < last)
+            {
+                std::iter_swap(first, last);
+                while (comp(*++first, pivot))
+                {
+                }
+                while (!comp(*--last, pivot))
+                {
+                }
+            }
+
+            Iterator pivotPosition{ first - 1 };
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return { pivotPosition, alreadyPartitioned };
+        }
+
+        // Like partitionRight, but elements equal to the pivot go left. Used when the
+        // pivot equals the element before the range: then everything equal to it is in
+        // its final place, so runs of duplicates are dealt with in one step.
+        template <typename Iterator, typename Compare>
+        Iterator partitionLeft(Iterator begin, Iterator end, Compare& comp)
+        {
+            auto pivot{ std::move(*begin) };
+            Iterator first{ begin };
+            Iterator last{ end };
+
+            while (comp(pivot, *--last))
+            {
+            }
+            if (last + 1 == end)
+            {
+                while (first < last && !comp(pivot, *++first))
+                {
+                }
+            }
+            else
+            {
+                while (!comp(pivot, *++first))
+                {
+                }
+            }
+
+            while (first < last)
+            {
+                std::iter_swap(first, last);
+                while (comp(pivot, *--last))
+                {
+                }
+                while (!comp(pivot, *++first))
+                {
+                }
+            }
+
+            Iterator pivotPosition{ last };
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return pivotPosition;
+        }
+
+        // Swaps num pairs of misplaced elements found by partitionRightBranchless. When
+        // there are more on one side it rotates them through a temporary instead, which
+        // needs one move per element rather than three.
+        template <typename Iterator>
+        void swapOffsets(Iterator first, Iterator last, const unsigned char* leftOffsets,
+                         const unsigned char* rightOffsets, std::size_t num, bool useSwaps)
+        {
+            if (useSwaps)
+            {
+                for (std::size_t i{ 0 }; i < num; ++i)
+                    std::iter_swap(first + leftOffsets[i], last - rightOffsets[i]);
+            }
+            else if (num > 0)
+            {
+                Iterator left{ first + leftOffsets[0] };
+                Iterator right{ last - rightOffsets[0] };
+                auto value{ std::move(*left) };
+                *left = std::move(*right);
+                for (std::size_t i{ 1 }; i < num; ++i)
+                {
+                    left = first + leftOffsets[i];
+                    *right = std::move(*left);
+                    right = last - rightOffsets[i];
+                    *left = std::move(*right);
+                }
+                *right = std::move(value);
+            }
+        }
+
+        // partitionRight without a branch per element (Edelkamp and Weiss' BlockQuicksort).
+        // A block of 64 elements from each end is compared against the pivot, writing
+        // down the offsets of the ones on the wrong side: the offset is always written
+        // and the count only goes up by the result of the compare. Then the misplaced
+        // elements are swapped in one go. On random numbers, where an ordinary partition
+        // mispredicts half its branches, this is much faster.
+        template <typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partitionRightBranchless(Iterator begin, Iterator end, Compare& comp)
+        {
+            constexpr std::size_t blockSize{ 64 };
+
+            auto pivot{ std::move(*begin) };
+            Iterator first{ begin };
+            Iterator last{ end };
+
+            while (comp(*++first, pivot))
+            {
+            }
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot))
+                {
+                }
+            }
+            else
+            {
+                while (!comp(*--last, pivot))
+                {
+                }
+            }
+
+            bool alreadyPartitioned{ first >= last };
+            if (!alreadyPartitioned)
+            {
+                std::iter_swap(first, last);
+                ++first;
+
+                alignas(64) unsigned char leftOffsets[blockSize];
+                alignas(64) unsigned char rightOffsets[blockSize];
+                Iterator leftBase{ first };
+                Iterator rightBase{ last };
+                std::size_t numLeft{ 0 };
+                std::size_t numRight{ 0 };
+                std::size_t startLeft{ 0 };
+                std::size_t startRight{ 0 };
+
+                while (first < last)
+                {
+                    // Refill whichever side ran out of offsets. Near the end, split what
+                    // is left between the two sides.
+                    std::size_t unknown{ static_cast<std::size_t>(last - first) };
+                    std::size_t leftSplit{ numLeft == 0 ? (numRight == 0 ? unknown / 2 : unknown) : 0 };
+                    std::size_t rightSplit{ numRight == 0 ? unknown - leftSplit : 0 };
+
+                    for (std::size_t i{ 0 }, count{ std::min(leftSplit, blockSize) }; i < count; ++i)
+                    {
+                        leftOffsets[numLeft] = static_cast<unsigned char>(i);
+                        numLeft += !comp(*first, pivot);
+                        ++first;
+                    }
+                    for (std::size_t i{ 0 }, count{ std::min(rightSplit, blockSize) }; i < count;)
+                    {
+                        rightOffsets[numRight] = static_cast<unsigned char>(++i);
+                        numRight += comp(*--last, pivot);
+                    }
+
+                    std::size_t num{ std::min(numLeft, numRight) };
+                    swapOffsets(leftBase, rightBase, leftOffsets + startLeft, rightOffsets + startRight,
+                                num, numLeft == numRight);
+                    numLeft -= num;
+                    numRight -= num;
+                    startLeft += num;
+                    startRight += num;
+                    if (numLeft == 0)
+                    {
+                        startLeft = 0;
+                        leftBase = first;
+                    }
+                    if (numRight == 0)
+                    {
+                        startRight = 0;
+                        rightBase = last;
+                    }
+                }
+
+                // Whatever is still misplaced on one side goes to the middle
+                if (numLeft)
+                {
+                    while (numLeft--)
+                        std::iter_swap(leftBase + leftOffsets[startLeft + numLeft], --last);
+                    first = last;
+                }
+                if (numRight)
+                {
+                    while (numRight--)
+                        std::iter_swap(rightBase - rightOffsets[startRight + numRight], first++);
+                    last = first;
+                }
+            }
+
+            Iterator pivotPosition{ first - 1 };
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return { pivotPosition, alreadyPartitioned };
+        }
+
+        template <bool Branchless, typename Iterator, typename Compare>
+        void pdqLoop(Iterator begin, Iterator end, Compare& comp, int badAllowed, bool leftmost)
+        {
+            for (;;)
+            {
+                std::ptrdiff_t size{ end - begin };
+                if (size < insertionSortSize)
+                {
+                    if (leftmost)
+                        insertionSort(begin, end, comp);
+                    else
+                        unguardedInsertionSort(begin, end, comp);
+                    return;
+                }
+
+                // Pivot: median of 3, or on big ranges the median of 3 medians of 3 (the
+                // "ninther"), moved to the front
+                std::ptrdiff_t half{ size / 2 };
+                if (size > nintherSize)
+                {
+                    sort3(begin, begin + half, end - 1, comp);
+                    sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                    sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                    sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                    std::iter_swap(begin, begin + half);
+                }
+                else
+                    sort3(begin + half, begin, end - 1, comp);
+
+                // A pivot equal to the element before the range is the smallest value in
+                // it, so split off everything equal to it
+                if (!leftmost && !comp(*(begin - 1), *begin))
+                {
+                    begin = partitionLeft(begin, end, comp) + 1;
+                    continue;
+                }
+
+                auto [pivot, alreadyPartitioned]{ Branchless ? partitionRightBranchless(begin, end, comp)
+                                                            : partitionRight(begin, end, comp) };
+                std::ptrdiff_t leftSize{ pivot - begin };
+                std::ptrdiff_t rightSize{ end - (pivot + 1) };
+
+                if (leftSize < size / 8 || rightSize < size / 8)
+                {
+                    // A bad split. After too many, switch to heapsort for a guaranteed
+                    // O(n log n); until then, swap a few elements around to break up
+                    // whatever pattern is fooling the pivot choice
+                    if (--badAllowed == 0)
+                    {
+                        std::make_heap(begin, end, comp);
+                        std::sort_heap(begin, end, comp);
+                        return;
+                    }
+
+                    if (leftSize >= insertionSortSize)
+                    {
+                        std::iter_swap(begin, begin + leftSize / 4);
+                        std::iter_swap(pivot - 1, pivot - leftSize / 4);
+                        if (leftSize > nintherSize)
+                        {
+                            std::iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+                            std::iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+                            std::iter_swap(pivot - 2, pivot - (leftSize / 4 + 1));
+                            std::iter_swap(pivot - 3, pivot - (leftSize / 4 + 2));
+                        }
+                    }
+                    if (rightSize >= insertionSortSize)
+                    {
+                        std::iter_swap(pivot + 1, pivot + (1 + rightSize / 4));
+                        std::iter_swap(end - 1, end - rightSize / 4);
+                        if (rightSize > nintherSize)
+                        {
+                            std::iter_swap(pivot + 2, pivot + (2 + rightSize / 4));
+                            std::iter_swap(pivot + 3, pivot + (3 + rightSize / 4));
+                            std::iter_swap(end - 2, end - (1 + rightSize / 4));
+                            std::iter_swap(end - 3, end - (2 + rightSize / 4));
+                        }
+                    }
+                }
+                else if (alreadyPartitioned
+                         && partialInsertionSort(begin, pivot, comp)
+                         && partialInsertionSort(pivot + 1, end, comp))
+                {
+                    // Nothing moved, so the input may well be sorted already: a cheap
+                    // insertion sort of both sides checks that and finishes the job
+                    return;
+                }
+
+                // Recurse on the left side, loop on the right
+                pdqLoop<Branchless>(begin, pivot, comp, badAllowed, leftmost);
+                begin = pivot + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    // Pattern-defeating quicksort (Orson Peters, 2021). Not stable. Needs random access.
+    // Numbers sorted with std::less or std::greater get the branchless block partition.
+    template <typename Iterator, typename Compare = std::less<>>
+    void pdqSort(Iterator first, Iterator last, Compare comp = {})
+    {
+        std::ptrdiff_t size{ last - first };
+        if (size < 2)
+            return;
+
+        int log2{ 0 };
+        for (; size > 1; size /= 2)
+            ++log2;
+
+        // Comparing numbers with < or > is cheap enough that the block partition pays off
+        using T = typename std::iterator_traits<Iterator>::value_type;
+        constexpr bool branchless{ std::is_arithmetic_v<T>
+                                   && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>
+                                       || std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>) };
+        detail::pdqLoop<branchless>(first, last, comp, log2, true);
+    }
+
+    namespace detail
+    {
+        // Calls work(t) for t in 0..threadCount, one of them on the calling thread
+        template <typename Work>
+        void runThreads(unsigned threadCount, Work work)
+        {
+            std::vector<std::thread> threads;
+            for (unsigned t{ 1 }; t < threadCount; ++t)
+                threads.emplace_back(work, t);
+            work(0u);
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+    }
+
+    // Stable merge sort on threadCount threads (0 for one per hardware thread). Each
+    // thread sorts a slice with std::stable_sort, then pairs of sorted runs are merged
+    // until one is left. Every merge is cut into pieces that threads take in turn, so
+    // the last merges, with few runs left, still keep every thread busy. The elements
+    // must be default constructible (for the merge buffer).
+    template <typename Iterator, typename Compare = std::less<>>
+    void parallelMergeSort(Iterator first, Iterator last, Compare comp = {}, unsigned threadCount = 0)
+    {
+        using T = typename std::iterator_traits<Iterator>::value_type;
+
+        std::size_t size{ static_cast<std::size_t>(last - first) };
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        if (threadCount == 1 || size < (std::size_t{ 1 } << 15))
+        {
+            std::stable_sort(first, last, comp);
+            return;
+        }
+
+        std::vector<std::size_t> runStart(threadCount + 1);
+        for (unsigned t{ 0 }; t <= threadCount; ++t)
+            runStart[t] = size * t / threadCount;
+        detail::runThreads(threadCount, [&](unsigned t) {
+            std::stable_sort(first + runStart[t], first + runStart[t + 1], comp);
+        });
+
+        // The runs go back and forth between the input and a buffer
+        std::vector<T> buffer(size);
+        bool inBuffer{ false };
+        const std::size_t piecesPerMerge{ threadCount };
+
+        while (runStart.size() > 2)
+        {
+            struct Piece
+            {
+                std::size_t left, leftEnd, right, rightEnd, out;
+            };
+            std::vector<Piece> pieces;
+            std::vector<std::size_t> nextStart{ 0 };
+
+            auto at{ [&](std::size_t i) -> T& { return inBuffer ? buffer[i] : *(first + i); } };
+
+            for (std::size_t r{ 0 }; r + 1 < runStart.size(); r += 2)
+            {
+                std::size_t begin{ runStart[r] };
+                std::size_t middle{ runStart[r + 1] };
+                std::size_t end{ r + 2 < runStart.size() ? runStart[r + 2] : middle };
+
+                // Cut the left run evenly, and the right run where each cut's element
+                // would go (lower_bound, so equal elements from the left run come first)
+                std::size_t leftCut{ begin };
+                std::size_t rightCut{ middle };
+                for (std::size_t p{ 1 }; p <= piecesPerMerge; ++p)
+                {
+                    std::size_t leftNext{ p == piecesPerMerge ? middle : begin + (middle - begin) * p / piecesPerMerge };
+                    std::size_t rightNext{ end };
+                    if (p != piecesPerMerge)
+                    {
+                        std::size_t low{ rightCut };
+                        std::size_t high{ end };
+                        while (low < high)
+                        {
+                            std::size_t mid{ low + (high - low) / 2 };
+                            if (comp(at(mid), at(leftNext)))
+                                low = mid + 1;
+                            else
+                                high = mid;
+                        }
+                        rightNext = low;
+                    }
+                    pieces.push_back({ leftCut, leftNext, rightCut, rightNext, leftCut + (rightCut - middle) });
+                    leftCut = leftNext;
+                    rightCut = rightNext;
+                }
+                nextStart.push_back(end);
+            }
+
+            std::atomic<std::size_t> nextPiece{ 0 };
+            detail::runThreads(threadCount, [&](unsigned) {
+                for (std::size_t p{ nextPiece++ }; p < pieces.size(); p = nextPiece++)
+                {
+                    const Piece& piece{ pieces[p] };
+                    std::size_t left{ piece.left };
+                    std::size_t right{ piece.right };
+                    std::size_t out{ piece.out };
+                    auto put{ [&](std::size_t from) {
+                        if (inBuffer)
+                            *(first + out++) = std::move(buffer[from]);
+                        else
+                            buffer[out++] = std::move(*(first + from));
+                    } };
+                    while (left < piece.leftEnd && right < piece.rightEnd)
+                    {
+                        if (comp(at(right), at(left)))
+                            put(right++);
+                        else
+                            put(left++);
+                    }
+                    while (left < piece.leftEnd)
+                        put(left++);
+                    while (right < piece.rightEnd)
+                        put(right++);
+                }
+            });
+
+            runStart.swap(nextStart);
+            inBuffer = !inBuffer;
+        }
+
+        if (inBuffer)
+            std::move(buffer.begin(), buffer.end(), first);
+    }
+
+    namespace detail
+    {
+        // The bits of value as an unsigned integer of the same size that sorts the same
+        // way. For floating point this is IEEE totalOrder: -NaN < -inf < ... < -0.0 <
+        // +0.0 < ... < +inf < +NaN.
+        template <typename T>
+        auto radixKey(T value)
+        {
+            using Unsigned = std::conditional_t<sizeof(T) == 8, std::uint64_t,
+                             std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                             std::conditional_t<sizeof(T) == 2, std::uint16_t, std::uint8_t>>>;
+            constexpr Unsigned signBit{ static_cast<Unsigned>(Unsigned{ 1 } << (8 * sizeof(T) - 1)) };
+
+            Unsigned bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            if constexpr (std::is_floating_point_v<T>)
+                return static_cast<Unsigned>((bits & signBit) ? ~bits : bits | signBit);
+            else if constexpr (std::is_signed_v<T>)
+                return static_cast<Unsigned>(bits ^ signBit);
+            else
+                return bits;
+        }
+    }
+
+    // LSD radix sort of integers, float or double, a byte per pass. All the byte counts
+    // are taken in one read, and a pass is skipped when every element has the same
+    // byte there. Stable; floating point is put in IEEE totalOrder (see radixKey).
+    template <typename T>
+    void radixSort(T* first, T* last)
+    {
+        static_assert(std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+                      "radixSort() sorts integers, float or double");
+
+        std::size_t size{ static_cast<std::size_t>(last - first) };
+        if (size < 64)
+        {
+            insertionSort(first, last, [](T a, T b) { return detail::radixKey(a) < detail::radixKey(b); });
+            return;
+        }
+
+        constexpr std::size_t passes{ sizeof(T) };
+        std::vector<std::size_t> counts(passes * 256);
+        for (std::size_t i{ 0 }; i < size; ++i)
+        {
+            auto key{ detail::radixKey(first[i]) };
+            for (std::size_t pass{ 0 }; pass < passes; ++pass)
+                ++counts[pass * 256 + ((key >> (8 * pass)) & 0xFF)];
+        }
+
+        std::unique_ptr<T[]> buffer{ new T[size] };
+        T* from{ first };
+        T* to{ buffer.get() };
+        for (std::size_t pass{ 0 }; pass < passes; ++pass)
+        {
+            std::size_t* next{ &counts[pass * 256] };
+            if (next[(detail::radixKey(from[0]) >> (8 * pass)) & 0xFF] == size)
+                continue;
+
+            std::size_t position{ 0 };
+            for (std::size_t digit{ 0 }; digit < 256; ++digit)
+            {
+                std::size_t count{ next[digit] };
+                next[digit] = position;
+                position += count;
+            }
+
+            for (std::size_t i{ 0 }; i < size; ++i)
+                to[next[(detail::radixKey(from[i]) >> (8 * pass)) & 0xFF]++] = from[i];
+            std::swap(from, to);
+        }
+
+        if (from != first)
+            std::memcpy(first, from, size * sizeof(T));
+    }
+}
+
+#endif
@@ -0,0 +1,311 @@
+// Header file that defines sortByKey() and orderByKey()
+//
+// Sorts records by a number that a projection pulls out of each one, such as
+// [](const Student& s) { return s.grade; }. Compared with std::sort and a comparison
+// function:
+//   - each key is read once, into a flat array, instead of twice per comparison
+//   - the sort is a counting sort (for keys in a small range, like grades) or an
+//     MSD radix sort on up to 16 bits at a time (for any other keys), so it takes
+//     about linear time, and it's stable: records with equal keys keep their order
+//   - the sort moves keys and indices, and the records themselves are moved just
+//     once, straight to their final place, instead of being swapped around
+//   - records that are plain numbers are sorted together with their keys instead,
+//     so there are no indices and no random reads to gather the records afterwards
+//
+// Keys can be integers, float or double. Floating-point keys are sorted by their
+// bits, turned into unsigned integers that compare the same way. Two values have
+// no natural place, so the policy is:
+//   - -0.0 and +0.0 are equal (as they are for <), so they keep their input order
+//   - NaNs go last, in either order, and keep their input order among themselves
+
+#ifndef KEYSORT_H
+#define KEYSORT_H
+
+#include <algorithm> // for std::min(), std::max(), std::sort(), std::stable_sort(), std::copy(), std::move()
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy()
+#include <iterator> // for std::begin()
+#include <limits>
+#include <memory> // for std::unique_ptr
+#include <type_traits>
+#include <utility> // for std::move()
+#include <vector>
+
+enum class SortOrder
+{
+    ascending,
+    descending,
+};
+
+namespace keysort_detail
+{
+    // Keys in a range at most this wide get a counting sort
+    constexpr std::uint64_t countingRange{ 1 << 16 };
+
+    // Up to this many records a plain stable sort of the items is quicker
+    constexpr std::size_t smallSort{ 64 };
+
+    struct Item
+    {
+        std::uint64_t key;
+        std::size_t index;
+    };
+
+    // When the records are numbers, an item carries the record itself instead of its
+    // index, so the sorted records are read straight out of the items
+    template <typename Value>
+    struct ValueItem
+    {
+        std::uint64_t key;
+        Value value;
+    };
+
+    // Sorts a few items by key, keeping equal keys in their order. Items with an index
+    // can use std::sort, comparing indices on ties; the others need std::stable_sort.
+    inline void sortSmall(Item* items, std::size_t count)
+    {
+        std::sort(items, items + count, [](const Item& a, const Item& b) {
+            return a.key != b.key ? a.key < b.key : a.index < b.index;
+        });
+    }
+
+    template <typename Value>
+    void sortSmall(ValueItem<Value>* items, std::size_t count)
+    {
+        std::stable_sort(items, items + count, [](const ValueItem<Value>& a, const ValueItem<Value>& b) {
+            return a.key < b.key;
+        });
+    }
+
+    // Maps a key to an unsigned integer that sorts the same way, or the opposite way
+    // for descending. For integers, flipping the sign bit puts negative numbers first.
+    // For floating point, flipping the sign bit of positive numbers and every bit of
+    // negative ones does the same (a negative number with a bigger magnitude has
+    // bigger bits, so its bits must be reversed).
+    template <typename Key>
+    std::uint64_t toUnsigned(Key key, SortOrder order)
+    {
+        static_assert(std::is_integral_v<Key> || std::is_same_v<Key, float> || std::is_same_v<Key, double>,
+                      "sortByKey() needs an integer, float or double key");
+
+        constexpr std::uint64_t signBit{ std::uint64_t{ 1 } << 63 };
+        std::uint64_t mapped{};
+        if constexpr (std::is_floating_point_v<Key>)
+        {
+            if (key != key) // NaN
+                return std::numeric_limits<std::uint64_t>::max();
+
+            double value{ key == 0 ? 0.0 : static_cast<double>(key) }; // -0.0 becomes +0.0
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            mapped = (bits & signBit) ? ~bits : bits | signBit;
+        }
+        else if constexpr (std::is_signed_v<Key>)
+            mapped = static_cast<std::uint64_t>(static_cast<std::int64_t>(key)) ^ signBit;
+        else
+            mapped = static_cast<std::uint64_t>(key);
+
+        // No other key maps to 0 or to all ones, so NaNs stay last either way
+        return order == SortOrder::descending ? ~mapped : mapped;
+    }
+
+    template <typename ItemType, typename Visit>
+    void countingSort(const ItemType* items, std::size_t count, std::uint64_t range, Visit visit)
+    {
+        std::vector<std::size_t> next(range + 1);
+        for (std::size_t i{ 0 }; i < count; ++i)
+            ++next[items[i].key];
+
+        std::size_t position{ 0 };
+        for (std::size_t& bucketSize : next)
+        {
+            std::size_t size{ bucketSize };
+            bucketSize = position;
+            position += size;
+        }
+
+        std::unique_ptr<ItemType[]> sorted{ new ItemType[count] };
+        for (std::size_t i{ 0 }; i < count; ++i)
+            sorted[next[items[i].key]++] = items[i];
+        for (std::size_t i{ 0 }; i < count; ++i)
+            visit(sorted[i]);
+    }
+
+    // Ranges of at most this many items are finished with std::sort, in cache
+    constexpr std::size_t bucketSort{ 256 };
+
+    // Sorts items[0..count) by key, keeping equal keys in index order. The keys differ
+    // only in their low bits. An MSD radix pass spreads the items over up to 65536
+    // buckets by the top ones (one pass over memory), and each bucket is sorted the
+    // same way on the bits where its keys differ, until it's small enough for std::sort.
+    template <typename ItemType>
+    void radixSort(ItemType* items, ItemType* buffer, std::size_t count, int bits)
+    {
+        if (count <= bucketSort || bits <= 0)
+        {
+            sortSmall(items, count);
+            return;
+        }
+
+        // About 8 items per bucket, and at most 16 bits a pass
+        int digitBits{ 1 };
+        while (digitBits < 16 && digitBits < bits && (std::size_t{ 1 } << (digitBits + 3)) < count)
+            ++digitBits;
+        int shift{ bits - digitBits };
+        std::size_t digitMask{ (std::size_t{ 1 } << digitBits) - 1 };
+
+        std::vector<std::size_t> next(std::size_t{ 1 } << digitBits);
+        for (std::size_t i{ 0 }; i < count; ++i)
+            ++next[(items[i].key >> shift) & digitMask];
+
+        std::vector<std::size_t> bucketStart(next.size() + 1);
+        std::size_t position{ 0 };
+        for (std::size_t digit{ 0 }; digit < next.size(); ++digit)
+        {
+            bucketStart[digit] = position;
+            position += next[digit];
+            next[digit] = bucketStart[digit];
+        }
+        bucketStart[next.size()] = count;
+
+        for (std::size_t i{ 0 }; i < count; ++i)
+            buffer[next[(items[i].key >> shift) & digitMask]++] = items[i];
+        std::copy(buffer, buffer + count, items);
+
+        for (std::size_t digit{ 0 }; digit < next.size(); ++digit)
+        {
+            std::size_t first{ bucketStart[digit] };
+            std::size_t size{ bucketStart[digit + 1] - first };
+            if (size <= 1)
+                continue;
+            if (size <= bucketSort)
+            {
+                sortSmall(items + first, size);
+                continue;
+            }
+
+            // Bits the bucket's keys all share needn't be passed over again: sort on the
+            // bits from the highest one that differs. A bucket of one key is already in
+            // index order, so it's done.
+            std::uint64_t minimum{ items[first].key };
+            std::uint64_t maximum{ minimum };
+            for (std::size_t i{ first + 1 }; i < first + size; ++i)
+            {
+                minimum = std::min(minimum, items[i].key);
+                maximum = std::max(maximum, items[i].key);
+            }
+            if (minimum != maximum)
+                radixSort(items + first, buffer + first, size, 64 - __builtin_clzll(minimum ^ maximum));
+        }
+    }
+
+    // Sorts items[0..count), whose keys lie in [minimum, maximum], and calls visit(item)
+    // for each one in stable sorted order
+    template <typename ItemType, typename Visit>
+    void sortItems(ItemType* items, std::size_t count, std::uint64_t minimum, std::uint64_t maximum, Visit visit)
+    {
+        std::uint64_t range{ maximum - minimum };
+
+        if (count <= smallSort || range == 0)
+        {
+            sortSmall(items, count);
+            for (std::size_t i{ 0 }; i < count; ++i)
+                visit(items[i]);
+            return;
+        }
+
+        // Both sorts work on key - minimum, so a narrow range needs few counters or passes
+        for (std::size_t i{ 0 }; i < count; ++i)
+            items[i].key -= minimum;
+
+        if (range < countingRange || range < count)
+        {
+            countingSort(items, count, range, visit);
+            return;
+        }
+
+        std::unique_ptr<ItemType[]> buffer{ new ItemType[count] };
+        radixSort(items, buffer.get(), count, 64 - __builtin_clzll(range));
+        for (std::size_t i{ 0 }; i < count; ++i)
+            visit(items[i]);
+    }
+
+    // Maps the key of every record into an item made by makeItem(mapped key, i),
+    // finding the smallest and largest mapped key on the way, then sorts the items
+    template <typename ItemType, typename Container, typename Projection, typename MakeItem, typename Visit>
+    void visitSorted(const Container& records, Projection key, SortOrder order, MakeItem makeItem, Visit visit)
+    {
+        std::size_t count{ records.size() };
+        if (count == 0)
+            return;
+
+        // Left uninitialized: every item is written just below
+        std::unique_ptr<ItemType[]> items{ new ItemType[count] };
+        std::uint64_t minimum{ std::numeric_limits<std::uint64_t>::max() };
+        std::uint64_t maximum{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            std::uint64_t mapped{ toUnsigned(key(records[i]), order) };
+            items[i] = makeItem(mapped, i);
+            minimum = std::min(minimum, mapped);
+            maximum = std::max(maximum, mapped);
+        }
+
+        sortItems(items.get(), count, minimum, maximum, visit);
+    }
+}
+
+// Returns the indices of records in sorted order of key(record). The sort is stable.
+// Records can be any container with size() and [], like std::vector or std::array.
+template <typename Container, typename Projection>
+std::vector<std::size_t> orderByKey(const Container& records, Projection key,
+                                    SortOrder order = SortOrder::ascending)
+{
+    std::vector<std::size_t> sortedOrder;
+    sortedOrder.reserve(records.size());
+    keysort_detail::visitSorted<keysort_detail::Item>(
+        records, key, order,
+        [](std::uint64_t mapped, std::size_t index) { return keysort_detail::Item{ mapped, index }; },
+        [&](const keysort_detail::Item& item) { sortedOrder.push_back(item.index); });
+    return sortedOrder;
+}
+
+// Sorts records by key(record), keeping records with equal keys in their order
+template <typename Container, typename Projection>
+void sortByKey(Container& records, Projection key, SortOrder order = SortOrder::ascending)
+{
+    using Record = typename Container::value_type;
+
+    if constexpr (std::is_arithmetic_v<Record>)
+    {
+        // Numbers are sorted inside the items, with no indices and no gather pass after
+        using ValueItem = keysort_detail::ValueItem<Record>;
+        std::size_t position{ 0 };
+        keysort_detail::visitSorted<ValueItem>(
+            records, key, order,
+            [&](std::uint64_t mapped, std::size_t index) { return ValueItem{ mapped, records[index] }; },
+            [&](const ValueItem& item) { records[position++] = item.value; });
+        return;
+    }
+
+    std::vector<std::size_t> sortedOrder{ orderByKey(records, key, order) };
+
+    // The records are read in a random order, so fetch each one a few steps ahead
+    constexpr std::size_t prefetchDistance{ 16 };
+    std::vector<Record> sorted;
+    sorted.reserve(records.size());
+    for (std::size_t i{ 0 }; i < sortedOrder.size(); ++i)
+    {
+        if (i + prefetchDistance < sortedOrder.size())
+            __builtin_prefetch(&records[sortedOrder[i + prefetchDistance]]);
+        sorted.push_back(std::move(records[sortedOrder[i]]));
+    }
+
+    if constexpr (std::is_same_v<Container, std::vector<Record>>)
+        records = std::move(sorted);
+    else
+        std::move(sorted.begin(), sorted.end(), std::begin(records));
+}
+
+#endif
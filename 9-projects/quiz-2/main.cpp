@@ -1,8 +1,8 @@
 #include <iostream>
-#include <algorithm>
 #include <vector>
 #include <string>
 #include <limits>
+#include "keysort.h"
 
 void ignoreLine()
 {
@@ -43,14 +43,9 @@ std::vector<Student> getStudents()
     return students;
 }
 
-bool greater(Student a, Student b)
-{
-    return (a.grade > b.grade);
-}
-
 void printStudents(const std::vector<Student> &students)
 {
-    for (Student student : students)
+    for (const Student& student : students)
     {
         std::cout << student.name << " got a grade of " << student.grade << '\n';
     }
@@ -61,8 +56,8 @@ int main()
     // get user input
     std::vector<Student> students = getStudents();
 
-    // sort
-    std::sort(std::begin(students), std::end(students), greater);
+    // sort by grade, highest first (students with the same grade stay in the order entered)
+    sortByKey(students, [](const Student& student) { return student.grade; }, SortOrder::descending);
 
     // print
     printStudents(students);
@@ -1,16 +1,19 @@
+#include <cstddef>
+#include <cstring> // for std::strlen()
 #include <iostream>
+#include <string>
 
 void printCString(const char* strptr)
 {
-    // print until we reach the null character
-    while (*strptr != '\0')
-    {
-        // print the current character
-        std::cout << *strptr << '\n';
+    // find the null character once (std::strlen checks many bytes per step),
+    // then build every "character, newline" pair and print them in one write
+    std::size_t length{ std::strlen(strptr) };
 
-        // increment the pointer
-        ++strptr;
-    }
+    std::string out(2 * length, '\n');
+    for (std::size_t i{ 0 }; i < length; ++i)
+        out[2 * i] = strptr[i];
+
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
 }
 
 int main()